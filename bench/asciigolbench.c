@@ -0,0 +1,364 @@
+/**
+ * @file asciigolbench.c
+ * @brief Benchmark of the Game of Life backends over a fixed matrix of
+ *        patterns.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <asciigol.h>
+#include <parsing.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Usage information explaining how to run the program.
+ */
+static const char* USAGE =
+	"Usage: asciigolbench [arguments]\n"
+	"Parameters:\n"
+	"\t--generations=<uint64> generations stepped per run\n"
+	"\t--repetitions=<uint16> runs per benchmark\n"
+	"\t--max-size=<uint32>    largest width and height of a random soup\n"
+	"\t--format={csv,json}    output format";
+
+/**
+ * @brief Output formats of the benchmark results.
+ */
+typedef enum {
+	FORMAT_CSV,
+	FORMAT_JSON
+} format_t;
+
+/**
+ * @brief Arguments to be given to the benchmark program.
+ */
+typedef struct {
+	uint64_t generations;
+	uint16_t repetitions;
+	uint32_t max_size;
+	format_t format;
+} bench_args_t;
+
+/**
+ * @brief A pattern to benchmark, either a bundled configuration file or, if
+ *        `filename` is NULL, a random soup generated from a fixed seed.
+ */
+typedef struct {
+	const char* name;
+	const char* filename;
+	uint32_t size;
+	uint8_t density_percent;
+} pattern_t;
+
+/**
+ * @brief The timings of the runs of one benchmark.
+ */
+typedef struct {
+	double min;
+	double median;
+} timing_t;
+
+/**
+ * @brief The default number of generations stepped per run.
+ */
+static const uint64_t DEFAULT_GENERATIONS = 200;
+
+/**
+ * @brief The default number of runs per benchmark.
+ */
+static const uint16_t DEFAULT_REPETITIONS = 5;
+
+/**
+ * @brief The default largest width and height of a random soup.
+ */
+static const uint32_t DEFAULT_MAX_SIZE = 2048;
+
+/**
+ * @brief The smallest width and height of a random soup, quadrupled up to the
+ *        largest.
+ */
+static const uint32_t MIN_SIZE = 32;
+
+/**
+ * @brief The seed of every random soup, so that runs are reproducible.
+ */
+static const uint64_t SEED = 0x5EED0A5C11601ULL;
+
+/**
+ * @brief The densities of the random soups, in percent of live cells.
+ */
+static const uint8_t DENSITIES[] = { 33, 50 };
+
+/**
+ * @brief The bundled configuration files.
+ */
+static const char* const CONFIGS[] = {
+	"glider",
+	"gosper_glider_gun",
+	"lightweight_spaceship",
+	"lobster",
+	"one_third_100x40",
+	"one_third_25x25"
+};
+
+/**
+ * @brief The directory holding the bundled configuration files.
+ */
+static const char* const CONFIG_DIR = "./config";
+
+/**
+ * @brief The backends benchmarked, along with their names.
+ */
+static const asciigol_backend_t BACKENDS[] = {
+	ASCIIGOL_BACKEND_BYTE,
+	ASCIIGOL_BACKEND_BITBOARD,
+	ASCIIGOL_BACKEND_HASHLIFE,
+	ASCIIGOL_BACKEND_PLANE
+};
+static const char* const BACKEND_NAMES[] = { "byte", "bitboard", "hashlife", "plane" };
+
+/**
+ * @brief The number of nanoseconds per second.
+ */
+static const double NANOS_PER_SECOND = 1e9;
+
+/**
+ * @brief Parse provided command-line arguments.
+ * @param[in,out] args The parsed arguments.
+ * @param[in] argc The number of arguments to parse.
+ * @param[in] argv The list of arguments to parse.
+ * @return True if the arguments were parsed successfully, false otherwise.
+ */
+static bool parse_args(bench_args_t* const args, const int argc, char** const argv);
+
+/**
+ * @brief Compare two doubles for sorting in ascending order.
+ * @param[in] a The first double.
+ * @param[in] b The second double.
+ * @return Negative, zero, or positive as a is less than, equal to, or greater
+ *         than b.
+ */
+static int compare_doubles(const void* a, const void* b);
+
+/**
+ * @brief Restore the initial state of the pattern of an engine, outside the
+ *        timed region of a run.
+ * @param[in,out] engine The engine.
+ * @param[in] pattern The pattern the engine was created with.
+ * @return True if the state was restored, false otherwise.
+ */
+static bool reset_engine(asciigol_engine_t* const engine, const pattern_t* const pattern);
+
+/**
+ * @brief Run one benchmark repeatedly, timing only the stepping of each run
+ *        per cell and generation.
+ *
+ * Every run steps exactly the requested number of generations, carrying on
+ * past convergence and cycles, so that every backend is timed over the same
+ * generations.
+ *
+ * @param[in] args The arguments of the benchmark program.
+ * @param[in] pattern The pattern benchmarked.
+ * @param[in,out] engine The engine holding the initial state of the pattern.
+ * @param[out] timing The timings of the runs.
+ * @return True if every run succeeded, false otherwise.
+ */
+static bool run_benchmark(
+	const bench_args_t* const args,
+	const pattern_t* const pattern,
+	asciigol_engine_t* const engine,
+	timing_t* const timing
+);
+
+/**
+ * @brief Benchmark a pattern with every backend, with and without wrapping.
+ * @param[in] args The arguments of the benchmark program.
+ * @param[in] pattern The pattern to benchmark.
+ * @param[in,out] num_results The number of results printed so far.
+ * @return True if every benchmark succeeded, false otherwise.
+ */
+static bool bench_pattern(const bench_args_t* const args, const pattern_t* const pattern, uint32_t* const num_results);
+
+/**
+ * @brief Print the result of one benchmark.
+ * @param[in] args The arguments of the benchmark program.
+ * @param[in] game The arguments of each run of the Game of Life.
+ * @param[in] pattern The pattern benchmarked.
+ * @param[in] timing The timings of the runs.
+ * @param[in] is_first Specify whether this is the first result printed.
+ */
+static void print_result(
+	const bench_args_t* const args,
+	const asciigol_args_t* const game,
+	const pattern_t* const pattern,
+	const timing_t* const timing,
+	const bool is_first
+);
+
+int main(int argc, char** argv) {
+	bench_args_t args = { DEFAULT_GENERATIONS, DEFAULT_REPETITIONS, DEFAULT_MAX_SIZE, FORMAT_CSV };
+	if (!parse_args(&args, argc, argv))
+		return EXIT_FAILURE;
+	if (args.format == FORMAT_CSV)
+		printf("backend,pattern,width,height,wrap,generations,repetitions,"
+		       "min_ns_per_cell_gen,median_ns_per_cell_gen\n");
+	else
+		printf("[\n");
+
+	uint32_t num_results = 0;
+	bool success = true;
+	char path[FILENAME_MAX];
+	for (size_t i = 0; success && i < sizeof(CONFIGS) / sizeof(CONFIGS[0]); i++) {
+		snprintf(path, sizeof(path), "%s/%s.asciigol", CONFIG_DIR, CONFIGS[i]);
+		const pattern_t pattern = { CONFIGS[i], path, 0, 0 };
+		success = bench_pattern(&args, &pattern, &num_results);
+	}
+	for (uint32_t size = MIN_SIZE; success && size <= args.max_size; size *= 4)
+		for (size_t i = 0; success && i < sizeof(DENSITIES); i++) {
+			char name[32];
+			snprintf(name, sizeof(name), "soup_%u", DENSITIES[i]);
+			const pattern_t pattern = { name, NULL, size, DENSITIES[i] };
+			success = bench_pattern(&args, &pattern, &num_results);
+		}
+
+	if (args.format == FORMAT_JSON)
+		printf("\n]\n");
+	if (!success)
+		fprintf(stderr, "Benchmark failed\n");
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool parse_args(bench_args_t* const args, const int argc, char** const argv) {
+	for (int i = 1; i < argc; i++) {
+		char* arg = argv[i];
+		bool parsed = false;
+		if (skip_prefix(&arg, "--generations="))
+			parsed = parse_uint64(arg, &args->generations) && args->generations;
+		else if (skip_prefix(&arg, "--repetitions="))
+			parsed = parse_uint16(arg, &args->repetitions) && args->repetitions;
+		else if (skip_prefix(&arg, "--max-size="))
+			parsed = parse_uint32(arg, &args->max_size);
+		else if (skip_prefix(&arg, "--format=")) {
+			parsed = !strcmp(arg, "csv") || !strcmp(arg, "json");
+			args->format = strcmp(arg, "json") ? FORMAT_CSV : FORMAT_JSON;
+		}
+		if (!parsed) {
+			fprintf(stderr, "Failed to parse: %s\n%s\n", argv[i], USAGE);
+			return false;
+		}
+	}
+	return true;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+	const double x = *(const double*)a;
+	const double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+static bool reset_engine(asciigol_engine_t* const engine, const pattern_t* const pattern) {
+	if (pattern->filename)
+		return asciigol_engine_load(engine, pattern->filename) == ASCIIGOL_OK;
+	return asciigol_engine_reseed(engine, SEED) == ASCIIGOL_OK;
+}
+
+static bool run_benchmark(
+	const bench_args_t* const args,
+	const pattern_t* const pattern,
+	asciigol_engine_t* const engine,
+	timing_t* const timing
+) {
+	double* const samples = (double*)malloc(args->repetitions * sizeof(double));
+	if (!samples)
+		return false;
+	uint32_t width, height;
+	asciigol_engine_get_size(engine, &width, &height);
+	bool success = true;
+	for (uint16_t i = 0; success && i < args->repetitions; i++) {
+		// the engine starts out in the initial state, which later runs restore
+		if (i && !reset_engine(engine, pattern)) {
+			success = false;
+			break;
+		}
+
+		// one generation at a time, as a step of many generations stops early
+		// once the state converges or cycles, except with hashlife, which
+		// would jump over them at once
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (uint64_t generation = 0; success && generation < args->generations; generation++) {
+			const asciigol_result_t result = asciigol_engine_step(engine, 1);
+			success = result == ASCIIGOL_OK || result == ASCIIGOL_CONVERGED || result == ASCIIGOL_CYCLED;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		const double elapsed = (double)(end.tv_sec - start.tv_sec) * NANOS_PER_SECOND + (double)(end.tv_nsec - start.tv_nsec);
+		samples[i] = elapsed / ((double)width * height * args->generations);
+	}
+	if (success) {
+		qsort(samples, args->repetitions, sizeof(double), compare_doubles);
+		timing->min = samples[0];
+		timing->median = samples[args->repetitions / 2];
+	}
+	free(samples);
+	return success;
+}
+
+static bool bench_pattern(const bench_args_t* const args, const pattern_t* const pattern, uint32_t* const num_results) {
+	asciigol_args_t game = { 0 };
+	game.filename = (char*)pattern->filename;
+	game.width = pattern->size;
+	game.height = pattern->size;
+	game.seed = SEED;
+	game.density = pattern->density_percent;
+	for (size_t i = 0; i < sizeof(BACKENDS) / sizeof(BACKENDS[0]); i++)
+		for (uint8_t wrap = 0; wrap <= 1; wrap++) {
+			// the unbounded backends have no edges to wrap
+			const bool is_unbounded = BACKENDS[i] == ASCIIGOL_BACKEND_HASHLIFE || BACKENDS[i] == ASCIIGOL_BACKEND_PLANE;
+			if (wrap && is_unbounded)
+				continue;
+			game.backend = BACKENDS[i];
+			game.wrap = wrap;
+
+			// the engine is built outside the timed runs, which only step it
+			asciigol_engine_t* engine;
+			if (asciigol_engine_create(&engine, game) != ASCIIGOL_OK)
+				return false;
+			timing_t timing = { 0 };
+			const bool success = run_benchmark(args, pattern, engine, &timing);
+			asciigol_engine_get_size(engine, &game.width, &game.height);
+			asciigol_engine_destroy(engine);
+			if (!success)
+				return false;
+			print_result(args, &game, pattern, &timing, *num_results == 0);
+			(*num_results)++;
+		}
+	return true;
+}
+
+static void print_result(
+	const bench_args_t* const args,
+	const asciigol_args_t* const game,
+	const pattern_t* const pattern,
+	const timing_t* const timing,
+	const bool is_first
+) {
+	const char* const backend = BACKEND_NAMES[game->backend];
+	if (args->format == FORMAT_CSV)
+		printf("%s,%s,%" PRIu32 ",%" PRIu32 ",%s,%" PRIu64 ",%" PRIu16 ",%.4f,%.4f\n",
+		       backend, pattern->name, game->width, game->height, game->wrap ? "true" : "false",
+		       args->generations, args->repetitions, timing->min, timing->median);
+	else
+		printf("%s\t{\"backend\": \"%s\", \"pattern\": \"%s\", \"width\": %" PRIu32 ", \"height\": %" PRIu32
+		       ", \"wrap\": %s, \"generations\": %" PRIu64 ", \"repetitions\": %" PRIu16
+		       ", \"min_ns_per_cell_gen\": %.4f, \"median_ns_per_cell_gen\": %.4f}",
+		       is_first ? "" : ",\n", backend, pattern->name, game->width, game->height,
+		       game->wrap ? "true" : "false", args->generations, args->repetitions,
+		       timing->min, timing->median);
+	fflush(stdout);
+}
@@ -10,6 +10,7 @@
 #define ASCIIGOL_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -21,18 +22,38 @@ typedef enum {
 	ASCIIGOL_BG_DARK,
 } asciigol_bg_t;
 
+/**
+ * @brief Enumeration denoting how the grid is stored and stepped.
+ */
+typedef enum {
+	ASCIIGOL_BACKEND_BYTE,
+	ASCIIGOL_BACKEND_BITBOARD,
+	ASCIIGOL_BACKEND_HASHLIFE,
+	ASCIIGOL_BACKEND_PLANE,
+} asciigol_backend_t;
+
 /**
  * @brief Arguments to be given to the asciigol program.
  */
 typedef struct {
-	uint8_t width;
-	uint8_t height;
+	uint32_t width;
+	uint32_t height;
 	uint16_t delay;
+	uint16_t threads;
+	uint16_t max_period;
+	uint64_t generations;
+	uint64_t jump;
+	uint64_t seed;
+	uint8_t density;
 	char* filename;
+	char* rule;
 	char live_char;
 	char dead_char;
 	bool wrap;
+	bool headless;
+	bool stats;
 	asciigol_bg_t background;
+	asciigol_backend_t backend;
 } asciigol_args_t;
 
 /**
@@ -45,14 +66,195 @@ typedef enum {
 	ASCIIGOL_BAD_HEADER,
 	ASCIIGOL_BAD_DIMENSION,
 	ASCIIGOL_BAD_CELL,
+	ASCIIGOL_CYCLED,
+	ASCIIGOL_BAD_THREADS,
+	ASCIIGOL_BAD_RULE,
 } asciigol_result_t;
 
+/**
+ * @brief Name a result code as it is spelled in this header.
+ * @param[in] result The result code.
+ * @return The name of the result code, or NULL if it is not recognized.
+ */
+const char* asciigol_result_name(const asciigol_result_t result);
+
+/**
+ * @brief Summary of a finished asciigol run.
+ *
+ * The population is the number of live cells in the final generation. When
+ * the run ends in `ASCIIGOL_CONVERGED` (a period of one) or `ASCIIGOL_CYCLED`,
+ * the period is the number of generations after which the grid repeats, and
+ * the cycle start is the first generation of the cycle. The missed deadlines
+ * are the number of frames that took longer than the delay to compute and
+ * render. The seed is the one the random initial state was generated from, or
+ * zero if it was loaded from a file.
+ */
+typedef struct {
+	uint64_t generations;
+	uint64_t population;
+	uint32_t period;
+	uint64_t cycle_start;
+	uint64_t missed_deadlines;
+	uint64_t seed;
+} asciigol_summary_t;
+
 /**
  * @brief Execute ASCII Game of Life.
  * @param[in] args A structure of arguments to configure asciigol with.
+ * @param[out] summary The summary of the run, or NULL if not needed.
  * @return An enum denoting the asciigol result code.
  */
-asciigol_result_t asciigol(asciigol_args_t args);
+asciigol_result_t asciigol(asciigol_args_t args, asciigol_summary_t* const summary);
+
+/**
+ * @brief A Game of Life simulation driven by its caller, one batch of
+ *        generations at a time, without rendering to the terminal or waiting
+ *        between generations.
+ */
+typedef struct asciigol_engine asciigol_engine_t;
+
+/**
+ * @brief Create an engine holding the initial state configured by the
+ *        arguments: the configuration file, or a random state of the given
+ *        dimensions, seed, and density.
+ *
+ * The backend, rule, threads, wrapping, cycle detection, and characters are
+ * also taken from the arguments, while the delay, jump, generations, headless,
+ * and stats arguments do not apply. The rule string is kept by the engine, so
+ * it must outlive it.
+ *
+ * @param[out] engine The created engine, to be destroyed with
+ *                    `asciigol_engine_destroy`.
+ * @param[in] args The arguments configuring the engine.
+ * @return An enum denoting the result of loading the initial state.
+ */
+asciigol_result_t asciigol_engine_create(asciigol_engine_t** const engine, asciigol_args_t args);
+
+/**
+ * @brief Replace the state of an engine with a pattern loaded from a file,
+ *        either a configuration file or a run-length encoded pattern.
+ *
+ * The generations are numbered from zero again. The state is left unchanged if
+ * the file cannot be loaded.
+ *
+ * @param[in,out] engine The engine.
+ * @param[in] filename The name of the file to load.
+ * @return An enum denoting the result of loading the file.
+ */
+asciigol_result_t asciigol_engine_load(asciigol_engine_t* const engine, const char* const filename);
+
+/**
+ * @brief Replace the state of an engine with a random state of another seed,
+ *        of the dimensions and density the engine was created with.
+ *
+ * The generations are numbered from zero again. If the state already is a
+ * random one of the byte or bitboard backend, its buffers are refilled rather
+ * than reallocated, so that many soups can be run in turn cheaply.
+ *
+ * @param[in,out] engine The engine.
+ * @param[in] seed The seed of the random state, zero denoting one picked from
+ *                 the clock.
+ * @return An enum denoting the result of generating the state.
+ */
+asciigol_result_t asciigol_engine_reseed(asciigol_engine_t* const engine, const uint64_t seed);
+
+/**
+ * @brief Advance an engine by a number of generations, stopping early if the
+ *        state converges or cycles.
+ *
+ * The hashlife backend instead computes a step of more than one generation
+ * as a single jump, in time roughly logarithmic in its length, which does
+ * not stop early and is never reported as converged or cycled. The history of
+ * generations restarts from the one the jump reaches, so that the following
+ * steps detect cycles again.
+ *
+ * @param[in,out] engine The engine.
+ * @param[in] generations The number of generations to advance by.
+ * @return `ASCIIGOL_OK` if every generation was computed, or
+ *         `ASCIIGOL_CONVERGED` or `ASCIIGOL_CYCLED` if the last one computed
+ *         repeats an earlier one.
+ */
+asciigol_result_t asciigol_engine_step(asciigol_engine_t* const engine, const uint64_t generations);
+
+/**
+ * @brief Retrieve the dimensions of the grid of an engine, which the unbounded
+ *        backends view their universe through.
+ * @param[in] engine The engine.
+ * @param[out] width The width of the grid.
+ * @param[out] height The height of the grid.
+ */
+void asciigol_engine_get_size(
+	const asciigol_engine_t* const engine,
+	uint32_t* const width,
+	uint32_t* const height
+);
+
+/**
+ * @brief Copy the cells of the grid of an engine.
+ * @param[in,out] engine The engine, whose viewport follows the live cells with
+ *                       the plane backend.
+ * @param[out] cells The cells, row by row, as zero (dead), one (live), or the
+ *                   dying states of a Generations rule from two upwards, of
+ *                   which there must be room for width * height.
+ */
+void asciigol_engine_get_cells(asciigol_engine_t* const engine, uint8_t* const cells);
+
+/**
+ * @brief Count the live cells of an engine.
+ * @param[in] engine The engine.
+ * @return The number of live cells, including those beyond the grid with the
+ *         unbounded backends, but not the dying cells of a Generations rule.
+ */
+uint64_t asciigol_engine_population(const asciigol_engine_t* const engine);
+
+/**
+ * @brief List the coordinates of the live cells of an engine.
+ *
+ * The plane backend lists every live cell of its universe, however far it has
+ * spread, whereas the other backends list those of the grid, with the
+ * top-left cell at 0, 0. Nothing is written if there is not room for every
+ * live cell, so the number needed can be queried with a capacity of zero.
+ *
+ * @param[in] engine The engine.
+ * @param[out] xs The column of each live cell.
+ * @param[out] ys The row of each live cell.
+ * @param[in] capacity The number of cells there is room for.
+ * @return The number of live cells listed, or needed.
+ */
+size_t asciigol_engine_get_live_cells(
+	asciigol_engine_t* const engine,
+	int64_t* const xs,
+	int64_t* const ys,
+	const size_t capacity
+);
+
+/**
+ * @brief Render the grid of an engine as text, one line per row of live and
+ *        dead characters, terminated by a null character.
+ *
+ * Nothing is written if the buffer is too small, so the size needed can be
+ * queried by passing a NULL buffer.
+ *
+ * @param[in,out] engine The engine, whose viewport follows the live cells with
+ *                       the plane backend.
+ * @param[out] buffer The buffer to render into, or NULL.
+ * @param[in] size The size of the buffer in bytes.
+ * @return The size needed in bytes: (width + 1) * height + 1.
+ */
+size_t asciigol_engine_render_into(asciigol_engine_t* const engine, char* const buffer, const size_t size);
+
+/**
+ * @brief Summarize the generations an engine has computed so far.
+ * @param[in] engine The engine.
+ * @param[out] summary The summary of the engine.
+ */
+void asciigol_engine_summarize(const asciigol_engine_t* const engine, asciigol_summary_t* const summary);
+
+/**
+ * @brief Destroy an engine, stopping its threads.
+ * @param[in,out] engine The engine, or NULL.
+ */
+void asciigol_engine_destroy(asciigol_engine_t* const engine);
 
 #endif // ASCIIGOL_H
 
@@ -15,8 +15,8 @@
  * @brief Arguments to be given to the asciigolgen program.
  */
 typedef struct {
-	uint8_t width;
-	uint8_t height;
+	uint32_t width;
+	uint32_t height;
 	char* filename;
 	char cell;
 } asciigolgen_args_t;
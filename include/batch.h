@@ -0,0 +1,50 @@
+/**
+ * @file batch.h
+ * @brief Simulation of many independent Game of Life universes at once.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <asciigol.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * @brief Simulate every universe of a list, each until it converges, cycles,
+ *        or reaches the generation limit, and write one record per universe.
+ *
+ * Each line of the list is either a nonzero 64-bit seed, made of digits
+ * only, of a random universe of the configured dimensions and density, or
+ * the name of a configuration file or run-length encoded pattern, which lines
+ * of digits that are not seeds are taken for. Blank lines are skipped.
+ *
+ * The universes are simulated concurrently by `args.threads` workers, zero
+ * denoting one per processor, each computing one universe at a time on a
+ * single thread. The universes are split evenly between the workers up front,
+ * and a worker that runs out steals half of the remaining universes of
+ * another, so uneven universes do not leave workers idle. Each worker reuses
+ * its grid from one random universe to the next.
+ *
+ * The records are written in the order of the list as comma-separated values
+ * under a header line: the seed or file, the result, the number of
+ * generations computed, the final population, and the period and first
+ * generation of the final cycle, if any. Without a generation limit, a
+ * universe that neither converges nor cycles within 100000 generations, such
+ * as one whose gliders escape into an unbounded backend, is given up on and
+ * recorded with the result `unstabilized`.
+ *
+ * @param[in] list The name of the file listing the universes.
+ * @param[in] args The arguments configuring every universe, of which
+ *                 `generations` is the generation limit, zero denoting the
+ *                 default.
+ * @param[in,out] stream The stream to write the records to.
+ * @return True if every universe was simulated, whatever its result, false if
+ *         the list could not be read or the workers could not be spawned.
+ */
+bool batch_run(const char* const list, asciigol_args_t args, FILE* const stream);
+
+#endif // BATCH_H
@@ -0,0 +1,153 @@
+/**
+ * @file bitboard.h
+ * @brief Bit-packed Game of Life grid storing 64 cells per word.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <rule.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The number of cells packed into a single word of a bitboard.
+ */
+#define BITBOARD_WORD_BITS 64
+
+/**
+ * @brief A Game of Life grid where each row is packed into 64-bit words.
+ *
+ * Column c of a row is stored in bit (c % 64) of word (c / 64). Bits beyond
+ * the width of the grid in the last word of each row are always zero.
+ */
+typedef struct {
+	uint32_t width;
+	uint32_t height;
+	size_t words_per_row;
+	uint64_t* words;
+} bitboard_t;
+
+/**
+ * @brief Allocate a bitboard with all cells dead.
+ * @param[out] board The bitboard to initialize.
+ * @param[in] width The width of the Game of Life grid.
+ * @param[in] height The height of the Game of Life grid.
+ * @return True if the allocation succeeded, false if it failed or its size
+ *         would overflow.
+ */
+bool bitboard_init(bitboard_t* const board, const uint32_t width, const uint32_t height);
+
+/**
+ * @brief Deallocate a bitboard.
+ * @param[in,out] board The bitboard to deallocate.
+ */
+void bitboard_destroy(bitboard_t* const board);
+
+/**
+ * @brief Pack a row of byte-per-cell values into a bitboard.
+ * @param[in,out] board The bitboard to write to.
+ * @param[in] row The row of the bitboard to write.
+ * @param[in] cells The cells of the row, where nonzero denotes a live cell.
+ */
+void bitboard_pack_row(
+	bitboard_t* const board,
+	const uint32_t row,
+	const uint8_t* const cells
+);
+
+/**
+ * @brief Unpack a row of a bitboard into byte-per-cell values.
+ * @param[in] board The bitboard to read from.
+ * @param[in] row The row of the bitboard to read.
+ * @param[out] cells The cells of the row as zero (dead) or one (live).
+ */
+void bitboard_unpack_row(
+	const bitboard_t* const board,
+	const uint32_t row,
+	uint8_t* const cells
+);
+
+/**
+ * @brief Count the live cells of a bitboard.
+ * @param[in] board The bitboard to count.
+ * @return The number of live cells.
+ */
+uint64_t bitboard_population(const bitboard_t* const board);
+
+/**
+ * @brief Compute the next generation of a bitboard, one word at a time.
+ * @param[in] board The current generation.
+ * @param[out] new_board The next generation, of the same dimensions.
+ * @param[in] wrap Specify whether the edges of the grid are connected.
+ * @param[in] rule The rule computing the next generation.
+ * @return True if the next generation differs from the current one.
+ */
+bool bitboard_step(
+	const bitboard_t* const board,
+	bitboard_t* const new_board,
+	const bool wrap,
+	const rule_t* const rule
+);
+
+/**
+ * @brief Compute the next generation of a band of rows of a bitboard.
+ *
+ * Bands that do not overlap may be computed concurrently.
+ *
+ * @param[in] board The current generation.
+ * @param[out] new_board The next generation, of the same dimensions.
+ * @param[in] wrap Specify whether the edges of the grid are connected.
+ * @param[in] rule The rule computing the next generation.
+ * @param[in] row_begin The first row of the band.
+ * @param[in] row_end One past the last row of the band.
+ * @return True if the band of the next generation differs from the current
+ *         one.
+ */
+bool bitboard_step_rows(
+	const bitboard_t* const board,
+	bitboard_t* const new_board,
+	const bool wrap,
+	const rule_t* const rule,
+	const uint32_t row_begin,
+	const uint32_t row_end
+);
+
+/**
+ * @brief Compute 64 cells of the next generation at once.
+ *
+ * The eight neighbors are summed with bitwise full adders, yielding a ones,
+ * twos, fours and eights bit per cell, to which the rule is applied. Life,
+ * HighLife, and Day & Night are applied as formulas of their own, whereas
+ * other rules test the counts of their masks one by one.
+ *
+ * @param[in] rule The rule computing the next generation.
+ * @param[in] above_w The row above, shifted such that bits hold west cells.
+ * @param[in] above The row above.
+ * @param[in] above_e The row above, shifted such that bits hold east cells.
+ * @param[in] west The current row, shifted such that bits hold west cells.
+ * @param[in] cells The current row.
+ * @param[in] east The current row, shifted such that bits hold east cells.
+ * @param[in] below_w The row below, shifted such that bits hold west cells.
+ * @param[in] below The row below.
+ * @param[in] below_e The row below, shifted such that bits hold east cells.
+ * @return The next generation of the 64 cells.
+ */
+uint64_t bitboard_compute_word(
+	const rule_t* const rule,
+	const uint64_t above_w,
+	const uint64_t above,
+	const uint64_t above_e,
+	const uint64_t west,
+	const uint64_t cells,
+	const uint64_t east,
+	const uint64_t below_w,
+	const uint64_t below,
+	const uint64_t below_e
+);
+
+#endif // BITBOARD_H
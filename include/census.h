@@ -0,0 +1,57 @@
+/**
+ * @file census.h
+ * @brief Census of the objects left behind by random Game of Life soups.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef CENSUS_H
+#define CENSUS_H
+
+#include <asciigol.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Run a number of random soups until they stabilize, classify the
+ *        objects left in their ash, and write a frequency table of them.
+ *
+ * Each soup is a random state of the configured dimensions and density,
+ * simulated in an unbounded plane so that gliders escape rather than crash
+ * into the edges. A soup is stable once it converges, cycles, or its
+ * population has repeated with a period of at most `args.max_period` for a
+ * few periods. The live cells are then split into connected components,
+ * merging the cells of a few generations so that the phases of an
+ * oscillator are kept together, and each component is simulated on its own
+ * to find its period and whether it moves. Its canonical hash is the least
+ * hash of its phases under every rotation and reflection, so that every
+ * orientation and phase of an object is counted as one.
+ *
+ * The soups are simulated by `args.threads` workers, zero denoting one per
+ * processor, each claiming one soup at a time. Soup i is generated from seed
+ * `args.seed` + i, a seed of zero being picked from the clock.
+ *
+ * The table is written as comma-separated values under a header line, most
+ * frequent first: the class of the object (`still_life`, `oscillator`,
+ * `glider`, `spaceship`, or `unclassified`), its period, its least
+ * population over its phases, its canonical hash, its number of
+ * occurrences, and the seed of a soup it occurred in. Soups that did not
+ * stabilize within `args.generations` generations are counted in a row of
+ * the class `unstabilized`.
+ *
+ * @param[in] num_soups The number of soups to run.
+ * @param[in] args The arguments configuring every soup, of which
+ *                 `generations` is the generation limit, zero denoting the
+ *                 default, and `rule` the rule both the soups and the
+ *                 objects are simulated under.
+ * @param[in,out] stream The stream to write the table to.
+ * @return `ASCIIGOL_OK` if every soup was run, `ASCIIGOL_BAD_RULE` if the
+ *         rule is invalid or a Generations rule, which the plane cannot hold,
+ *         `ASCIIGOL_BAD_THREADS` if the workers could not be spawned, or
+ *         `ASCIIGOL_BAD_DIMENSION` if they ran out of memory.
+ */
+asciigol_result_t census_run(const uint64_t num_soups, asciigol_args_t args, FILE* const stream);
+
+#endif // CENSUS_H
@@ -0,0 +1,79 @@
+/**
+ * @file cycle.h
+ * @brief Detection of periodic Game of Life generations by hashing.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef CYCLE_H
+#define CYCLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief A bounded history of generation hashes.
+ *
+ * The hashes of the last `max_period` + 1 generations, enough to close a cycle
+ * of `max_period` generations, are kept in `ring`, indexed by generation, and
+ * in an open-addressing table mapping each hash to the latest generation it
+ * was seen at, so each lookup costs O(1) regardless of the period limit.
+ */
+typedef struct {
+	uint32_t max_period;
+	uint64_t num_generations;
+	uint64_t* ring;
+	size_t table_mask;
+	uint64_t* table_hashes;
+	uint64_t* table_generations;
+} cycle_detector_t;
+
+/**
+ * @brief Initialize a cycle detector.
+ * @param[out] detector The cycle detector to initialize.
+ * @param[in] max_period The longest period that can be detected.
+ * @return True if the allocation succeeded, false otherwise.
+ */
+bool cycle_init(cycle_detector_t* const detector, const uint32_t max_period);
+
+/**
+ * @brief Record the hash of the next generation and look for a repeat.
+ *
+ * Generations are numbered from zero in the order they are recorded. Two
+ * generations are assumed identical when their 64-bit hashes are.
+ *
+ * @param[in,out] detector The cycle detector.
+ * @param[in] hash The hash of the generation.
+ * @param[out] start The generation the cycle started at, if one was found.
+ * @return The period of the detected cycle, or zero if there is none.
+ */
+uint32_t cycle_record(
+	cycle_detector_t* const detector,
+	const uint64_t hash,
+	uint64_t* const start
+);
+
+/**
+ * @brief Forget every generation recorded, numbering the next one zero.
+ * @param[in,out] detector The cycle detector.
+ */
+void cycle_clear(cycle_detector_t* const detector);
+
+/**
+ * @brief Deallocate a cycle detector.
+ * @param[in,out] detector The cycle detector.
+ */
+void cycle_destroy(cycle_detector_t* const detector);
+
+/**
+ * @brief Fold a block of memory into a 64-bit hash.
+ * @param[in] hash The hash to fold into, or zero to start a new hash.
+ * @param[in] data The memory to hash.
+ * @param[in] size The number of bytes to hash.
+ * @return The updated hash.
+ */
+uint64_t cycle_hash(uint64_t hash, const void* const data, const size_t size);
+
+#endif // CYCLE_H
@@ -0,0 +1,79 @@
+/**
+ * @file framebuf.h
+ * @brief Reusable byte buffer assembling a frame for a single write.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef FRAMEBUF_H
+#define FRAMEBUF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief A frame of terminal output under construction.
+ *
+ * The buffer is allocated once and reused for every frame by clearing it. It
+ * only grows if a frame outgrows it; should growing fail, the frame is
+ * flushed in several writes rather than lost.
+ */
+typedef struct {
+	char* data;
+	size_t length;
+	size_t capacity;
+	int fd;
+} framebuf_t;
+
+/**
+ * @brief Allocate a frame buffer.
+ * @param[out] frame The frame buffer to initialize.
+ * @param[in] capacity The number of bytes to preallocate.
+ * @param[in] fd The file descriptor the frame is written to.
+ * @return True if the allocation succeeded, false otherwise.
+ */
+bool framebuf_init(framebuf_t* const frame, const size_t capacity, const int fd);
+
+/**
+ * @brief Discard the contents of a frame buffer, keeping its allocation.
+ * @param[in,out] frame The frame buffer.
+ */
+void framebuf_clear(framebuf_t* const frame);
+
+/**
+ * @brief Append bytes to a frame buffer.
+ * @param[in,out] frame The frame buffer.
+ * @param[in] data The bytes to append.
+ * @param[in] size The number of bytes to append.
+ */
+void framebuf_append(framebuf_t* const frame, const char* const data, const size_t size);
+
+/**
+ * @brief Append a null-terminated string to a frame buffer.
+ * @param[in,out] frame The frame buffer.
+ * @param[in] string The string to append.
+ */
+void framebuf_append_string(framebuf_t* const frame, const char* const string);
+
+/**
+ * @brief Append a single character to a frame buffer.
+ * @param[in,out] frame The frame buffer.
+ * @param[in] character The character to append.
+ */
+void framebuf_append_char(framebuf_t* const frame, const char character);
+
+/**
+ * @brief Write the contents of a frame buffer with a single write, and clear
+ *        it.
+ * @param[in,out] frame The frame buffer.
+ */
+void framebuf_flush(framebuf_t* const frame);
+
+/**
+ * @brief Deallocate a frame buffer.
+ * @param[in,out] frame The frame buffer.
+ */
+void framebuf_destroy(framebuf_t* const frame);
+
+#endif // FRAMEBUF_H
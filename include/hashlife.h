@@ -0,0 +1,140 @@
+/**
+ * @file hashlife.h
+ * @brief Unbounded Game of Life universe stepped with memoized quadtrees.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef HASHLIFE_H
+#define HASHLIFE_H
+
+#include <rule.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The level of the largest quadtree node, whose side is 2^level cells.
+ */
+#define HASHLIFE_MAX_LEVEL 62
+
+/**
+ * @brief A node of a quadtree, referred to by its index in the node store.
+ *
+ * A node of level k covers a square of 2^k by 2^k cells, split into four
+ * children of level k - 1. Nodes of level zero are single cells. Nodes are
+ * hash-consed, so two nodes covering identical squares are the same node, and
+ * `result` memoizes the center of the node, half its size, some generations
+ * later.
+ */
+typedef struct {
+	uint32_t nw;
+	uint32_t ne;
+	uint32_t sw;
+	uint32_t se;
+	uint32_t result;
+	uint32_t next;
+	uint64_t population;
+	uint64_t hash;
+	uint8_t level;
+	bool is_marked;
+} hashlife_node_t;
+
+/**
+ * @brief An unbounded Game of Life universe held in a quadtree.
+ *
+ * The universe is the node `root`, whose top-left cell lies at `origin_x`,
+ * `origin_y`, and everything outside of it is dead. Nodes are stored in
+ * `nodes`, chained into the hash table `buckets` by their hash, or into a
+ * list starting at `free_node` once collected. Garbage is collected before a
+ * step once the store holds more than `gc_threshold` nodes, and the threshold
+ * doubles if less than half of the nodes could be collected. Every generation
+ * is computed under `rule`.
+ */
+typedef struct {
+	hashlife_node_t* nodes;
+	uint32_t num_nodes;
+	uint32_t num_free_nodes;
+	uint32_t capacity;
+	uint32_t free_node;
+	uint32_t* buckets;
+	uint32_t bucket_mask;
+	uint32_t gc_threshold;
+	uint32_t empty[HASHLIFE_MAX_LEVEL + 1];
+	uint32_t root;
+	int64_t origin_x;
+	int64_t origin_y;
+	uint8_t step_log2;
+	rule_t rule;
+} hashlife_t;
+
+/**
+ * @brief Build a universe from a grid of cells.
+ * @param[out] universe The universe to initialize.
+ * @param[in] cells The cells of the grid, where nonzero denotes a live cell.
+ * @param[in] stride The distance between the first cells of adjacent rows.
+ * @param[in] width The width of the grid, placed at x = 0.
+ * @param[in] height The height of the grid, placed at y = 0.
+ * @param[in] rule The rule computing every generation.
+ * @return True if the allocation succeeded, false otherwise.
+ */
+bool hashlife_init(
+	hashlife_t* const universe,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height,
+	const rule_t rule
+);
+
+/**
+ * @brief Deallocate a universe.
+ * @param[in,out] universe The universe to deallocate.
+ */
+void hashlife_destroy(hashlife_t* const universe);
+
+/**
+ * @brief Advance a universe by any number of generations.
+ *
+ * The generations are split into powers of two, each computed in time
+ * logarithmic in its size for patterns with enough regularity.
+ *
+ * @param[in,out] universe The universe to advance.
+ * @param[in] generations The number of generations to advance by.
+ * @return True if the universe was advanced, false if it ran out of memory or
+ *         outgrew the largest node.
+ */
+bool hashlife_step(hashlife_t* const universe, const uint64_t generations);
+
+/**
+ * @brief Read a span of cells of a row of a universe.
+ * @param[in] universe The universe to read from.
+ * @param[in] x The column of the first cell of the span.
+ * @param[in] y The row of the span.
+ * @param[in] width The number of cells in the span.
+ * @param[out] cells The cells of the span as zero (dead) or one (live).
+ */
+void hashlife_get_row(
+	const hashlife_t* const universe,
+	const int64_t x,
+	const int64_t y,
+	const uint32_t width,
+	uint8_t* const cells
+);
+
+/**
+ * @brief Count the live cells of a universe.
+ * @param[in] universe The universe to count.
+ * @return The number of live cells.
+ */
+uint64_t hashlife_population(const hashlife_t* const universe);
+
+/**
+ * @brief Hash the live cells of a universe along with their position.
+ * @param[in] universe The universe to hash.
+ * @return The hash of the universe.
+ */
+uint64_t hashlife_hash(const hashlife_t* const universe);
+
+#endif // HASHLIFE_H
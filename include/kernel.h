@@ -0,0 +1,96 @@
+/**
+ * @file kernel.h
+ * @brief Row stepping kernels for the byte-per-cell Game of Life grid.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <rule.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief The number of distinct 3x3 neighborhoods of cells.
+ */
+#define KERNEL_NUM_NEIGHBORHOODS 512
+
+/**
+ * @brief A row kernel along with the rule it computes.
+ */
+typedef struct kernel kernel_t;
+
+/**
+ * @brief A kernel computing the next generation of one row of cells.
+ *
+ * Each row pointer refers to column 0 of a row padded with a one-cell halo,
+ * such that column -1 and column `width` may be read.
+ *
+ * @param[in] kernel The kernel, holding the rule.
+ * @param[in] above The row above the row to compute.
+ * @param[in] cells The row to compute, as zero (dead) or one (live) bytes.
+ * @param[in] below The row below the row to compute.
+ * @param[out] new_cells The next generation of the row.
+ * @param[in] width The number of cells in the row.
+ * @return True if any cell of the row changed, false otherwise.
+ */
+typedef bool (*kernel_row_t)(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief A row kernel selected for a rule.
+ *
+ * `row` is called with the kernel itself. `table` holds the next state of
+ * the center cell of every 3x3 neighborhood, indexed by its cells column by
+ * column from the west, each column contributing three bits: above (lowest),
+ * center, and below. Sliding the neighborhood one cell east therefore shifts
+ * the index right by three bits and adds the new column as the highest bits.
+ */
+struct kernel {
+	kernel_row_t row;
+	rule_t rule;
+	uint8_t table[KERNEL_NUM_NEIGHBORHOODS];
+};
+
+/**
+ * @brief Select the fastest row kernel of a rule supported by the running
+ *        CPU, and build its lookup table.
+ *
+ * AVX2 (32 cells at a time) is preferred over SSE2 (16 cells at a time),
+ * falling back to the scalar kernel on CPUs or builds without either. Life,
+ * HighLife, and Day & Night have vector kernels of their own, in which the
+ * rule is compiled in, whereas other rules are looked up from their masks.
+ *
+ * @param[out] kernel The kernel to select.
+ * @param[in] rule The rule computed by the kernel.
+ */
+void kernel_select(kernel_t* const kernel, const rule_t rule);
+
+/**
+ * @brief Compute the next generation of a row one cell at a time.
+ *
+ * Each cell is looked up in the table of the kernel, indexed by its 3x3
+ * neighborhood, which is slid along the row such that only one new column is
+ * loaded per cell.
+ *
+ * @see kernel_row_t
+ */
+bool kernel_row_scalar(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+#endif // KERNEL_H
@@ -36,6 +36,22 @@ bool parse_uint8(const char* const arg, uint8_t* value);
  */
 bool parse_uint16(const char* const arg, uint16_t* value);
 
+/**
+ * @brief Parse a 32-bit unsigned integer from string.
+ * @param[in] arg The argument to parse.
+ * @param[out] value The parsed uint32.
+ * @return True if parsing succeeded, false otherwise.
+ */
+bool parse_uint32(const char* const arg, uint32_t* value);
+
+/**
+ * @brief Parse a 64-bit unsigned integer from string.
+ * @param[in] arg The argument to parse.
+ * @param[out] value The parsed uint64.
+ * @return True if parsing succeeded, false otherwise.
+ */
+bool parse_uint64(const char* const arg, uint64_t* value);
+
 /**
  * @brief Parse a character from a string.
  * @param[in] arg The argument to parse.
@@ -0,0 +1,173 @@
+/**
+ * @file plane.h
+ * @brief Unbounded Game of Life plane stored as a hash map of bit-packed
+ *        chunks.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef PLANE_H
+#define PLANE_H
+
+#include <rule.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The number of rows and columns of cells in a chunk.
+ */
+#define PLANE_CHUNK_SIZE 64
+
+/**
+ * @brief A square of cells of the plane, referred to by its index in the
+ *        chunk store.
+ *
+ * The chunk covers the cells from `x` * 64, `y` * 64 onwards, with column c of
+ * a row stored in bit c of its word. Each chunk is double-buffered, holding
+ * the current generation in `rows[current]` of the plane. `hash` caches the
+ * hash of the current generation, or zero if it is empty, `is_changed` records
+ * whether the last step changed the chunk, and `is_active` whether the next
+ * step computes it.
+ */
+typedef struct {
+	uint64_t rows[2][PLANE_CHUNK_SIZE];
+	int64_t x;
+	int64_t y;
+	uint64_t hash;
+	uint32_t next;
+	bool is_used;
+	bool is_changed;
+	bool is_active;
+} plane_chunk_t;
+
+/**
+ * @brief An unbounded Game of Life plane, of which only the chunks near live
+ *        cells are stored.
+ *
+ * Chunks are stored in `chunks`, chained into the hash table `buckets` by
+ * their coordinates, or into a list starting at `free_chunk` once freed. A
+ * chunk is allocated when live cells reach its edge and freed once it has
+ * stayed empty for a generation with no live cells in its neighbors. `hash` is
+ * the sum of the hashes of every chunk. Every generation is computed under
+ * `rule`.
+ */
+typedef struct {
+	plane_chunk_t* chunks;
+	uint32_t num_chunks;
+	uint32_t num_used_chunks;
+	uint32_t capacity;
+	uint32_t free_chunk;
+	uint32_t* buckets;
+	uint32_t bucket_mask;
+	uint64_t hash;
+	uint8_t current;
+	rule_t rule;
+} plane_t;
+
+/**
+ * @brief Build a plane from a grid of cells.
+ * @param[out] plane The plane to initialize.
+ * @param[in] cells The cells of the grid, where nonzero denotes a live cell.
+ * @param[in] stride The distance between the first cells of adjacent rows.
+ * @param[in] width The width of the grid, placed at x = 0.
+ * @param[in] height The height of the grid, placed at y = 0.
+ * @param[in] rule The rule computing every generation.
+ * @return True if the allocation succeeded, false otherwise.
+ */
+bool plane_init(
+	plane_t* const plane,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height,
+	const rule_t rule
+);
+
+/**
+ * @brief Deallocate a plane.
+ * @param[in,out] plane The plane to deallocate.
+ */
+void plane_destroy(plane_t* const plane);
+
+/**
+ * @brief Advance a plane by one generation.
+ *
+ * Only the chunks that changed in the previous generation, or that neighbor
+ * one that did, are computed.
+ *
+ * @param[in,out] plane The plane to advance.
+ * @param[out] changed Whether the next generation differs from the current
+ *                     one.
+ * @return True if the plane was advanced, false if it ran out of memory.
+ */
+bool plane_step(plane_t* const plane, bool* const changed);
+
+/**
+ * @brief Read a span of cells of a row of a plane.
+ * @param[in] plane The plane to read from.
+ * @param[in] x The column of the first cell of the span.
+ * @param[in] y The row of the span.
+ * @param[in] width The number of cells in the span.
+ * @param[out] cells The cells of the span as zero (dead) or one (live).
+ */
+void plane_get_row(
+	const plane_t* const plane,
+	const int64_t x,
+	const int64_t y,
+	const uint32_t width,
+	uint8_t* const cells
+);
+
+/**
+ * @brief Find the smallest rectangle holding every live cell of a plane.
+ * @param[in] plane The plane to measure.
+ * @param[out] x_min The leftmost column holding a live cell.
+ * @param[out] y_min The topmost row holding a live cell.
+ * @param[out] x_max The rightmost column holding a live cell.
+ * @param[out] y_max The bottommost row holding a live cell.
+ * @return True if the plane holds a live cell, false otherwise.
+ */
+bool plane_bounds(
+	const plane_t* const plane,
+	int64_t* const x_min,
+	int64_t* const y_min,
+	int64_t* const x_max,
+	int64_t* const y_max
+);
+
+/**
+ * @brief List the coordinates of the live cells of a plane, chunk by chunk.
+ *
+ * Nothing is written if there is not room for every live cell, so the number
+ * needed can be queried with a capacity of zero.
+ *
+ * @param[in] plane The plane to list.
+ * @param[out] xs The column of each live cell.
+ * @param[out] ys The row of each live cell.
+ * @param[in] capacity The number of cells there is room for.
+ * @return The number of live cells.
+ */
+size_t plane_list_cells(
+	const plane_t* const plane,
+	int64_t* const xs,
+	int64_t* const ys,
+	const size_t capacity
+);
+
+/**
+ * @brief Count the live cells of a plane.
+ * @param[in] plane The plane to count.
+ * @return The number of live cells.
+ */
+uint64_t plane_population(const plane_t* const plane);
+
+/**
+ * @brief Hash the live cells of a plane along with their position.
+ * @param[in] plane The plane to hash.
+ * @return The hash of the plane.
+ */
+uint64_t plane_hash(const plane_t* const plane);
+
+#endif // PLANE_H
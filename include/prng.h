@@ -0,0 +1,64 @@
+/**
+ * @file prng.h
+ * @brief Seeded pseudorandom generation of Game of Life soups.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+/**
+ * @brief The number of bits of precision of a probability, which is given as
+ *        a fraction of 2^16.
+ */
+#define PRNG_PROBABILITY_BITS 16
+
+/**
+ * @brief A xoshiro256** pseudorandom generator.
+ */
+typedef struct {
+	uint64_t state[4];
+} prng_t;
+
+/**
+ * @brief Seed a generator, such that generators seeded with the same seed and
+ *        stream produce the same words.
+ *
+ * Each stream of a seed is an independent sequence of words, so that separate
+ * parts of a soup can be generated in any order, or in parallel, and still be
+ * reproduced from the seed.
+ *
+ * @param[out] prng The generator to seed.
+ * @param[in] seed The seed.
+ * @param[in] stream The stream of the seed.
+ */
+void prng_seed(prng_t* const prng, const uint64_t seed, const uint64_t stream);
+
+/**
+ * @brief Generate the next word of a generator.
+ * @param[in,out] prng The generator.
+ * @return A uniformly distributed word.
+ */
+uint64_t prng_next(prng_t* const prng);
+
+/**
+ * @brief Generate a word of which each bit is independently set with a given
+ *        probability.
+ *
+ * Each bit of the probability, from the least to the most significant one
+ * that is set, combines another uniform word into the result with an OR if
+ * the bit is set or an AND otherwise, so a probability of one half costs a
+ * single word and any other costs at most 16.
+ *
+ * @param[in,out] prng The generator.
+ * @param[in] probability The probability of a bit being set, as a fraction of
+ *                        2^16; 2^16 or more sets every bit.
+ * @return The generated word.
+ */
+uint64_t prng_next_bits(prng_t* const prng, const uint32_t probability);
+
+#endif // PRNG_H
@@ -0,0 +1,89 @@
+/**
+ * @file ring.h
+ * @brief Lock-free single-producer, single-consumer ring of fixed-size frames.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef RING_H
+#define RING_H
+
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief A ring of frames handed from one producer thread to one consumer
+ *        thread.
+ *
+ * The producer writes frame `head` % `capacity` and the consumer reads frame
+ * `tail` % `capacity`, each publishing its progress with a single atomic
+ * store, so neither ever takes a lock. A thread only sleeps when the ring is
+ * full (producer) or empty (consumer), parking on `space` or `filled`, which
+ * the other thread posts after each frame. Once `is_closed`, the consumer
+ * drains the remaining frames and stops.
+ */
+typedef struct {
+	uint8_t* frames;
+	size_t frame_size;
+	uint32_t capacity;
+	atomic_uint_fast64_t head;
+	atomic_uint_fast64_t tail;
+	atomic_bool is_closed;
+	sem_t space;
+	sem_t filled;
+} ring_t;
+
+/**
+ * @brief Allocate a ring of frames.
+ * @param[out] ring The ring to initialize.
+ * @param[in] capacity The number of frames the ring holds.
+ * @param[in] frame_size The number of bytes of each frame.
+ * @return True if the allocation succeeded, false otherwise.
+ */
+bool ring_init(ring_t* const ring, const uint32_t capacity, const size_t frame_size);
+
+/**
+ * @brief Deallocate a ring of frames.
+ * @param[in,out] ring The ring to deallocate.
+ */
+void ring_destroy(ring_t* const ring);
+
+/**
+ * @brief Retrieve the next frame for the producer to write, waiting for the
+ *        consumer to free one if the ring is full.
+ * @param[in,out] ring The ring of frames.
+ * @return The frame to write.
+ */
+uint8_t* ring_begin_push(ring_t* const ring);
+
+/**
+ * @brief Hand the frame written by the producer to the consumer.
+ * @param[in,out] ring The ring of frames.
+ */
+void ring_end_push(ring_t* const ring);
+
+/**
+ * @brief Retrieve the next frame for the consumer to read, waiting for the
+ *        producer to write one if the ring is empty.
+ * @param[in,out] ring The ring of frames.
+ * @return The frame to read, or NULL if the ring is closed and empty.
+ */
+const uint8_t* ring_begin_pop(ring_t* const ring);
+
+/**
+ * @brief Hand the frame read by the consumer back to the producer.
+ * @param[in,out] ring The ring of frames.
+ */
+void ring_end_pop(ring_t* const ring);
+
+/**
+ * @brief Signal that the producer will write no more frames.
+ * @param[in,out] ring The ring of frames.
+ */
+void ring_close(ring_t* const ring);
+
+#endif // RING_H
@@ -0,0 +1,118 @@
+/**
+ * @file rle.h
+ * @brief Reading and writing of run-length encoded (RLE) patterns.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef RLE_H
+#define RLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief The longest rule string kept from a header, including the
+ *        terminating null character.
+ */
+#define RLE_MAX_RULE 64
+
+/**
+ * @brief Result codes of reading an RLE pattern.
+ */
+typedef enum {
+	RLE_OK,
+	RLE_BAD_HEADER,
+	RLE_BAD_DIMENSION,
+	RLE_BAD_CELL
+} rle_result_t;
+
+/**
+ * @brief The header line of an RLE pattern: `x = <width>, y = <height>`,
+ *        optionally followed by `, rule = <rule>`.
+ *
+ * `rule` is empty if the header does not specify one.
+ */
+typedef struct {
+	uint32_t width;
+	uint32_t height;
+	char rule[RLE_MAX_RULE];
+} rle_header_t;
+
+/**
+ * @brief Determine whether a pattern file is run-length encoded, either by
+ *        the `.rle` extension of its name or by its first character.
+ *
+ * An RLE file starts with a `#` comment line or its `x = ` header, whereas an
+ * asciigol configuration file starts with `asciigol`. Nothing is consumed
+ * from the file.
+ *
+ * @param[in] filename The name of the file.
+ * @param[in,out] file The file, positioned at its start.
+ * @return True if the file is run-length encoded, false otherwise.
+ */
+bool rle_detect(const char* const filename, FILE* const file);
+
+/**
+ * @brief Read the header of an RLE pattern, skipping the comment lines before
+ *        it.
+ * @param[in,out] file The file, positioned at its start.
+ * @param[out] header The header read.
+ * @return RLE_BAD_HEADER if the header is missing or malformed,
+ *         RLE_BAD_DIMENSION if the width or height is zero or too large, or
+ *         RLE_OK otherwise.
+ */
+rle_result_t rle_read_header(FILE* const file, rle_header_t* const header);
+
+/**
+ * @brief Decode the runs of an RLE pattern following its header.
+ *
+ * The file is read in large blocks and decoded as it streams, run by run, so
+ * the encoded pattern is never held in memory at once. Only the live cells are
+ * written, so the cells must be zeroed beforehand. Decoding stops at the `!`
+ * terminating the pattern, or at the end of the file.
+ *
+ * @param[in,out] file The file, positioned after the header.
+ * @param[in] header The header of the pattern.
+ * @param[out] cells The cells of the grid, of which the live ones are set to
+ *                   one.
+ * @param[in] stride The distance between the first cells of adjacent rows.
+ * @return RLE_BAD_DIMENSION if a run reaches beyond the width or height,
+ *         RLE_BAD_CELL if a character is neither a run count nor a `b`, `o`,
+ *         `$`, or `!` tag, or RLE_OK otherwise.
+ */
+rle_result_t rle_read_cells(
+	FILE* const file,
+	const rle_header_t* const header,
+	uint8_t* const cells,
+	const size_t stride
+);
+
+/**
+ * @brief Write a grid of cells as an RLE pattern of the Conway rule, B3/S23.
+ *
+ * Dead cells ending a row and empty rows ending the pattern are omitted, and
+ * lines are wrapped before 70 characters.
+ *
+ * @param[in,out] file The file to write to.
+ * @param[in] cells The cells of the grid.
+ * @param[in] stride The distance between the first cells of adjacent rows.
+ * @param[in] width The width of the grid.
+ * @param[in] height The height of the grid.
+ * @param[in] live The value of a live cell, any other value denoting a dead
+ *                 cell.
+ * @return True if the pattern was written, false otherwise.
+ */
+bool rle_write(
+	FILE* const file,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height,
+	const uint8_t live
+);
+
+#endif // RLE_H
@@ -0,0 +1,83 @@
+/**
+ * @file rule.h
+ * @brief Outer-totalistic Life-like rules compiled from rule strings.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef RULE_H
+#define RULE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief The rule string of Conway's Game of Life, the default rule.
+ */
+#define RULE_CONWAY "B3/S23"
+
+/**
+ * @brief The largest number of states of a cell, such that a state fits in a
+ *        byte.
+ */
+#define RULE_MAX_STATES 256
+
+/**
+ * @brief Enumeration denoting the rules for which specialized kernels exist,
+ *        every other rule being generic.
+ */
+typedef enum {
+	RULE_GENERIC,
+	RULE_LIFE,
+	RULE_HIGHLIFE,
+	RULE_DAY_AND_NIGHT,
+} rule_kind_t;
+
+/**
+ * @brief An outer-totalistic rule, where the next state of a cell only
+ *        depends on its state and the number of its live neighbors.
+ *
+ * Bit n of `birth` is set if a dead cell (state 0) with n live neighbors is
+ * born, and bit n of `survival` if a live cell (state 1) with n live
+ * neighbors survives. Life-like rules have two states, whereas the
+ * Generations rules of `num_states` states let a live cell that does not
+ * survive decay through states 2 up to `num_states` - 1, one per generation,
+ * before it dies. Only live cells count as neighbors, and decaying cells are
+ * never born again until they have died. `kind` names the rule if it has
+ * specialized kernels.
+ */
+typedef struct {
+	uint16_t birth;
+	uint16_t survival;
+	uint16_t num_states;
+	rule_kind_t kind;
+} rule_t;
+
+/**
+ * @brief Compile a rule string into the masks of its rule.
+ *
+ * The string is either in B/S notation, such as `B36/S23`, where the
+ * neighbor counts giving birth follow `B` and those giving survival follow
+ * `S`, in either order and either case, or in S/B notation, such as `23/36`,
+ * where the survival counts come first. A Generations rule appends its number
+ * of states as a third part, prefixed with `C` in B/S notation, such as
+ * `B2/S/C3` or `/2/3` for Brian's Brain. Rules giving birth to cells without
+ * live neighbors (B0) are rejected, as they would fill an unbounded plane.
+ *
+ * @param[in] string The rule string.
+ * @param[out] rule The compiled rule.
+ * @return True if the string denotes a rule, false otherwise.
+ */
+bool rule_parse(const char* const string, rule_t* const rule);
+
+/**
+ * @brief Determine whether a cell lives in the next generation.
+ * @param[in] rule The rule.
+ * @param[in] is_live Whether the cell is live.
+ * @param[in] num_live_neighbors The number of live neighbors of the cell.
+ * @return True if the cell is live in the next generation, false otherwise.
+ */
+bool rule_apply(const rule_t* const rule, const bool is_live, const uint8_t num_live_neighbors);
+
+#endif // RULE_H
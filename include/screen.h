@@ -0,0 +1,80 @@
+/**
+ * @file screen.h
+ * @brief Terminal screen repainting only the cells that changed.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <framebuf.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief A grid of colored characters drawn at the top-left of the terminal.
+ *
+ * Each frame is written into `chars` and `colors`, where the cell at a given
+ * row and column is at index (row * width + col) and its color indexes into
+ * `palette`. Presenting the frame compares it with the previously presented
+ * one, kept in `shown_chars` and `shown_colors`, and only emits the runs of
+ * cells that differ, falling back to repainting every cell when too many
+ * differ.
+ */
+typedef struct {
+	uint32_t width;
+	uint32_t height;
+	char* chars;
+	uint8_t* colors;
+	char* shown_chars;
+	uint8_t* shown_colors;
+	bool is_shown;
+	const char* const* palette;
+	framebuf_t frame;
+} screen_t;
+
+/**
+ * @brief Allocate a screen.
+ * @param[out] screen The screen to initialize.
+ * @param[in] width The number of columns of the screen.
+ * @param[in] height The number of rows of the screen.
+ * @param[in] palette The ANSI control codes of each color, the first of which
+ *                    must reset the terminal attributes to default.
+ * @param[in] fd The file descriptor the screen is written to.
+ * @return True if the allocation succeeded, false otherwise.
+ */
+bool screen_init(
+	screen_t* const screen,
+	const uint32_t width,
+	const uint32_t height,
+	const char* const* palette,
+	const int fd
+);
+
+/**
+ * @brief Draw the frame written into a screen.
+ *
+ * Every cell of the frame must have been written since the previous call. The
+ * cursor is left on the row below the screen, with the default colors.
+ *
+ * @param[in,out] screen The screen.
+ */
+void screen_present(screen_t* const screen);
+
+/**
+ * @brief Force the next frame to repaint every cell, such as after the
+ *        terminal was cleared.
+ * @param[in,out] screen The screen.
+ */
+void screen_invalidate(screen_t* const screen);
+
+/**
+ * @brief Deallocate a screen.
+ * @param[in,out] screen The screen.
+ */
+void screen_destroy(screen_t* const screen);
+
+#endif // SCREEN_H
@@ -0,0 +1,88 @@
+/**
+ * @file stats.h
+ * @brief Timing of the phases of a Game of Life run.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief The number of buckets of a phase histogram, bucket b counting the
+ *        samples of 2^b up to 2^(b+1) nanoseconds.
+ */
+#define STATS_BUCKETS 40
+
+/**
+ * @brief Phases of a Game of Life run that are timed.
+ */
+typedef enum {
+	STATS_INIT,
+	STATS_COMPUTE,
+	STATS_CAPTURE,
+	STATS_RENDER,
+	STATS_WAIT,
+	STATS_NUM_PHASES
+} stats_phase_t;
+
+/**
+ * @brief The samples of one phase, accumulated as they are recorded.
+ */
+typedef struct {
+	uint64_t count;
+	uint64_t total;
+	uint64_t min;
+	uint64_t max;
+	uint64_t histogram[STATS_BUCKETS];
+} stats_timer_t;
+
+/**
+ * @brief The timers of every phase of a run.
+ *
+ * Each timer is only recorded to by a single thread, so no synchronization is
+ * needed while the run lasts. When `is_enabled` is false, nothing is timed.
+ */
+typedef struct {
+	stats_timer_t timers[STATS_NUM_PHASES];
+	bool is_enabled;
+} stats_t;
+
+/**
+ * @brief Initialize the timers of a run.
+ * @param[out] stats The timers to initialize.
+ * @param[in] is_enabled Specify whether to time anything.
+ */
+void stats_init(stats_t* const stats, const bool is_enabled);
+
+/**
+ * @brief Read the monotonic clock if timing is enabled.
+ * @param[in] stats The timers.
+ * @return The current time in nanoseconds, or zero if timing is disabled.
+ */
+uint64_t stats_start(const stats_t* const stats);
+
+/**
+ * @brief Record the time elapsed since the start of a phase.
+ * @param[in,out] stats The timers.
+ * @param[in] phase The phase that ended.
+ * @param[in] start The time the phase started at, as read by `stats_start`.
+ * @return The current time in nanoseconds, from which a following phase may
+ *         be timed, or zero if timing is disabled.
+ */
+uint64_t stats_record(stats_t* const stats, const stats_phase_t phase, const uint64_t start);
+
+/**
+ * @brief Print the total, average, extremes, and histogram of every phase that
+ *        was recorded.
+ * @param[in] stats The timers.
+ * @param[in,out] stream The stream to print to.
+ */
+void stats_print(const stats_t* const stats, FILE* const stream);
+
+#endif // STATS_H
@@ -0,0 +1,78 @@
+/**
+ * @file threadpool.h
+ * @brief Persistent pool of threads splitting work into bands.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#pragma once
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief A task computing one band of work.
+ * @param[in,out] context The context shared by all bands.
+ * @param[in] band The index of the band to compute.
+ * @param[in] num_bands The total number of bands.
+ */
+typedef void (*threadpool_task_t)(void* context, const uint32_t band, const uint32_t num_bands);
+
+/**
+ * @brief A worker thread of the pool along with the band it computes.
+ */
+typedef struct threadpool_worker threadpool_worker_t;
+
+/**
+ * @brief A pool of threads that persist across runs.
+ *
+ * The calling thread computes band 0 itself, so a pool of N threads spawns
+ * N - 1 workers. Workers are woken for each run by bumping the generation,
+ * and all threads meet at a barrier once their bands are computed.
+ */
+typedef struct {
+	uint32_t num_threads;
+	threadpool_worker_t* workers;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_barrier_t finish;
+	uint64_t generation;
+	threadpool_task_t task;
+	void* context;
+	bool stopping;
+} threadpool_t;
+
+/**
+ * @brief Spawn the worker threads of a pool.
+ *
+ * The pool must not be moved in memory while it is running.
+ *
+ * @param[out] pool The pool to initialize.
+ * @param[in] num_threads The number of threads, including the caller.
+ * @return True if all threads were spawned, false otherwise.
+ */
+bool threadpool_init(threadpool_t* const pool, const uint32_t num_threads);
+
+/**
+ * @brief Run a task across all threads of a pool, one band per thread, and
+ *        wait for every band to finish.
+ * @param[in,out] pool The pool to run the task with.
+ * @param[in] task The task to run.
+ * @param[in,out] context The context given to each band of the task.
+ */
+void threadpool_run(
+	threadpool_t* const pool,
+	const threadpool_task_t task,
+	void* const context
+);
+
+/**
+ * @brief Stop and join the worker threads of a pool.
+ * @param[in,out] pool The pool to destroy.
+ */
+void threadpool_destroy(threadpool_t* const pool);
+
+#endif // THREADPOOL_H
@@ -6,7 +6,10 @@
  */
 
 #include <asciigol.h>
+#include <batch.h>
+#include <census.h>
 #include <parsing.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -19,33 +22,62 @@
 static const char* USAGE =
 	"Usage: asciigol [arguments]\n"
 	"Parameters:\n"
-	"\t--width=<uint8>        width of grid\n"
-	"\t--height=<uint8>       height of grid\n"
+	"\t--width=<uint32>       width of grid\n"
+	"\t--height=<uint32>      height of grid\n"
 	"\t--delay=<uint16>       delay between frames in milliseconds\n"
+	"\t--threads=<uint16>     number of threads computing the grid\n"
+	"\t--max-period=<uint16>  longest oscillator period to detect\n"
+	"\t--generations=<uint64> stop after this many generations\n"
+	"\t--jump=<uint64>        skip this many generations before rendering\n"
+	"\t--seed=<uint64>        seed of the random initial state\n"
+	"\t--density=<uint8>      percentage of live cells in the random initial state\n"
 	"\t--live-char=<char>     character representing a live cell\n"
 	"\t--dead-char=<char>     character representing a dead cell\n"
 	"\t--file=<string>        custom configuration file\n"
+	"\t--rule=<string>        rule in B/S notation, such as B36/S23, or with a\n"
+	"\t                       number of states, such as B2/S/C3, Conway's\n"
+	"\t                       B3/S23 by default\n"
+	"\t--batch=<string>       file listing seeds and configuration files of\n"
+	"\t                       universes to simulate, printing one record each\n"
+	"\t--census=<uint64>      run this many random soups and print a table of\n"
+	"\t                       the objects left once they stabilize\n"
 	"\t--bg={none,light,dark} enable background color: light or dark\n"
+	"\t--backend={byte,bitboard,hashlife,plane}\n"
+	"\t                       grid storage: byte per cell, 64 cells per word,\n"
+	"\t                       unbounded memoized quadtree, or unbounded chunks\n"
 	"\t--wrap                 reaching row/column limit will\n"
-	"\t                       wrap around to the other end";
+	"\t                       wrap around to the other end\n"
+	"\t--headless             step without rendering and print a summary\n"
+	"\t--stats                time each phase and print the timings to stderr";
+
+/**
+ * @brief Arguments selecting a mode of the program other than a single game.
+ */
+typedef struct {
+	char* batch;
+	uint64_t census;
+} mode_args_t;
 
 /**
  * @brief Parse a provided command-line argument.
  * @param[in,out] args The parsed arguments.
+ * @param[in,out] modes The parsed arguments selecting a mode.
  * @param[in] arg The argument to parse.
  * @return True if the argument was parsed successfully, false otherwise.
  */
-static bool parse_arg(asciigol_args_t* const args, char* arg);
+static bool parse_arg(asciigol_args_t* const args, mode_args_t* const modes, char* arg);
 
 /**
  * @brief Parse provided command-line arguments.
  * @param[in,out] args The parsed arguments.
+ * @param[in,out] modes The parsed arguments selecting a mode.
  * @param[in] argc The number of arguments to parse.
  * @param[in] argv The list of arguments to parse.
  * @return True if the arguments were parsed successfully, false otherwise.
  */
 static bool parse_args(
 	asciigol_args_t* const args,
+	mode_args_t* const modes,
 	const int argc,
 	char** const argv
 );
@@ -53,8 +85,18 @@ static bool parse_args(
 /**
  * @brief Print the result of the asciigol program as text.
  * @param[in] result The asciigol result.
+ * @param[in] summary The summary of the asciigol run.
+ */
+static void print_asciigol_result(
+	const asciigol_result_t result,
+	const asciigol_summary_t* const summary
+);
+
+/**
+ * @brief Print the summary of a headless asciigol run.
+ * @param[in] summary The summary of the asciigol run.
  */
-static void print_asciigol_result(const asciigol_result_t result);
+static void print_asciigol_summary(const asciigol_summary_t* const summary);
 
 /**
  * @brief Determine if the asciigol program ran successfully.
@@ -65,20 +107,49 @@ static bool is_asciigol_success(const asciigol_result_t result);
 
 int main(int argc, char** argv) {
 	asciigol_args_t args = { 0 };
-	if (!parse_args(&args, argc, argv))
+	mode_args_t modes = { 0 };
+	if (!parse_args(&args, &modes, argc, argv))
 		return EXIT_FAILURE;
-	asciigol_result_t result = asciigol(args);
-	print_asciigol_result(result);
+	asciigol_summary_t summary = { 0 };
+	if (modes.batch)
+		return batch_run(modes.batch, args, stdout) ? EXIT_SUCCESS : EXIT_FAILURE;
+	if (modes.census) {
+		// the table is only written by a successful census
+		const asciigol_result_t result = census_run(modes.census, args, stdout);
+		if (result != ASCIIGOL_OK)
+			print_asciigol_result(result, &summary);
+		return is_asciigol_success(result) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	asciigol_result_t result = asciigol(args, &summary);
+	if (args.headless && is_asciigol_success(result))
+		print_asciigol_summary(&summary);
+	if (summary.missed_deadlines)
+		printf("Missed deadlines: %" PRIu64 "\n", summary.missed_deadlines);
+	if (summary.seed)
+		printf("Seed: %" PRIu64 "\n", summary.seed);
+	print_asciigol_result(result, &summary);
 	return is_asciigol_success(result) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
-static bool parse_arg(asciigol_args_t* const args, char* arg) {
+static bool parse_arg(asciigol_args_t* const args, mode_args_t* const modes, char* arg) {
 	if (!args->width && skip_prefix(&arg, "--width="))
-		return parse_uint8(arg, &args->width);
+		return parse_uint32(arg, &args->width);
 	if (!args->height && skip_prefix(&arg, "--height="))
-		return parse_uint8(arg, &args->height);
+		return parse_uint32(arg, &args->height);
 	if (!args->delay && skip_prefix(&arg, "--delay="))
 		return parse_uint16(arg, &args->delay);
+	if (!args->threads && skip_prefix(&arg, "--threads="))
+		return parse_uint16(arg, &args->threads);
+	if (!args->max_period && skip_prefix(&arg, "--max-period="))
+		return parse_uint16(arg, &args->max_period);
+	if (!args->generations && skip_prefix(&arg, "--generations="))
+		return parse_uint64(arg, &args->generations);
+	if (!args->jump && skip_prefix(&arg, "--jump="))
+		return parse_uint64(arg, &args->jump);
+	if (!args->seed && skip_prefix(&arg, "--seed="))
+		return parse_uint64(arg, &args->seed);
+	if (!args->density && skip_prefix(&arg, "--density="))
+		return parse_uint8(arg, &args->density) && args->density <= 100;
 	if (!args->live_char && skip_prefix(&arg, "--live-char="))
 		return parse_char(arg, &args->live_char);
 	if (!args->dead_char && skip_prefix(&arg, "--dead-char="))
@@ -87,6 +158,16 @@ static bool parse_arg(asciigol_args_t* const args, char* arg) {
 		args->filename = arg;
 		return true;
 	}
+	if (!args->rule && skip_prefix(&arg, "--rule=")) {
+		args->rule = arg;
+		return true;
+	}
+	if (!modes->batch && skip_prefix(&arg, "--batch=")) {
+		modes->batch = arg;
+		return true;
+	}
+	if (!modes->census && skip_prefix(&arg, "--census="))
+		return parse_uint64(arg, &modes->census);
 	if (!args->background && skip_prefix(&arg, "--bg=")) {
 		if (!strcmp(arg, "none"))
 			args->background = ASCIIGOL_BG_NONE;
@@ -98,21 +179,43 @@ static bool parse_arg(asciigol_args_t* const args, char* arg) {
 			return false;
 		return true;
 	}
+	if (!args->backend && skip_prefix(&arg, "--backend=")) {
+		if (!strcmp(arg, "byte"))
+			args->backend = ASCIIGOL_BACKEND_BYTE;
+		else if (!strcmp(arg, "bitboard"))
+			args->backend = ASCIIGOL_BACKEND_BITBOARD;
+		else if (!strcmp(arg, "hashlife"))
+			args->backend = ASCIIGOL_BACKEND_HASHLIFE;
+		else if (!strcmp(arg, "plane"))
+			args->backend = ASCIIGOL_BACKEND_PLANE;
+		else
+			return false;
+		return true;
+	}
 	if (!args->wrap && !strcmp(arg, "--wrap")) {
 		args->wrap = true;
 		return true;
 	}
+	if (!args->headless && !strcmp(arg, "--headless")) {
+		args->headless = true;
+		return true;
+	}
+	if (!args->stats && !strcmp(arg, "--stats")) {
+		args->stats = true;
+		return true;
+	}
 	return false;
 }
 
 static bool parse_args(
 	asciigol_args_t* const args,
+	mode_args_t* const modes,
 	const int argc,
 	char** const argv
 ) {
 	for (int i = 1; i < argc; i++) {
 		char* const arg = argv[i];
-		if (!parse_arg(args, arg)) {
+		if (!parse_arg(args, modes, arg)) {
 			printf("Failed to parse: %s\n%s\n", arg, USAGE);
 			return false;
 		}
@@ -120,33 +223,28 @@ static bool parse_args(
 	return true;
 }
 
-static void print_asciigol_result(const asciigol_result_t result) {
-	printf("Result: ");
-	switch (result) {
-		case ASCIIGOL_OK:
-			printf("ASCIIGOL_OK (%d)\n", ASCIIGOL_OK);
-			break;
-		case ASCIIGOL_CONVERGED:
-			printf("ASCIIGOL_CONVERGED (%d)\n", ASCIIGOL_CONVERGED);
-			break;
-		case ASCIIGOL_BAD_FILE:
-			printf("ASCIIGOL_BAD_FILE (%d)\n", ASCIIGOL_BAD_FILE);
-			break;
-		case ASCIIGOL_BAD_HEADER:
-			printf("ASCIIGOL_BAD_HEADER (%d)\n", ASCIIGOL_BAD_HEADER);
-			break;
-		case ASCIIGOL_BAD_DIMENSION:
-			printf("ASCIIGOL_BAD_DIMENSION (%d)\n", ASCIIGOL_BAD_DIMENSION);
-			break;
-		case ASCIIGOL_BAD_CELL:
-			printf("ASCIIGOL_BAD_CELL (%d)\n", ASCIIGOL_BAD_CELL);
-			break;
-		default:
-			printf("result not recognized\n");
-	}
+static void print_asciigol_result(
+	const asciigol_result_t result,
+	const asciigol_summary_t* const summary
+) {
+	const char* const name = asciigol_result_name(result);
+	if (!name)
+		printf("Result: result not recognized\n");
+	else if (result == ASCIIGOL_CYCLED)
+		printf("Result: %s (%d): period %" PRIu32 " starting at generation %" PRIu64 "\n",
+		       name, result, summary->period, summary->cycle_start);
+	else
+		printf("Result: %s (%d)\n", name, result);
+}
+
+static void print_asciigol_summary(const asciigol_summary_t* const summary) {
+	printf("Generations: %" PRIu64 "\n", summary->generations);
+	printf("Population: %" PRIu64 "\n", summary->population);
 }
 
 static bool is_asciigol_success(const asciigol_result_t result) {
-	return result == ASCIIGOL_OK || result == ASCIIGOL_CONVERGED;
+	return result == ASCIIGOL_OK ||
+	       result == ASCIIGOL_CONVERGED ||
+	       result == ASCIIGOL_CYCLED;
 }
 
@@ -21,10 +21,10 @@
 static const char* USAGE =
 	"Usage: asciigolgen [arguments]\n"
 	"Parameters:\n"
-	"\t--file=<string>  name of configuration file to generate\n"
-	"\t--width=<uint8>  width of asciigol grid to configure\n"
-	"\t--height=<uint8> height of asciigol grid to configure\n"
-	"\t--cell=0|1       the cell state to initialize with";
+	"\t--file=<string>   name of configuration file to generate\n"
+	"\t--width=<uint32>  width of asciigol grid to configure\n"
+	"\t--height=<uint32> height of asciigol grid to configure\n"
+	"\t--cell=0|1        the cell state to initialize with";
 
 /**
  * @brief Parse a provided command-line argument.
@@ -75,9 +75,9 @@ static bool parse_arg(asciigolgen_args_t* const args, char* arg) {
 		return true;
 	}
 	if (!args->width && skip_prefix(&arg, "--width="))
-		return parse_uint8(arg, &args->width);
+		return parse_uint32(arg, &args->width);
 	if (!args->height && skip_prefix(&arg, "--height="))
-		return parse_uint8(arg, &args->height);
+		return parse_uint32(arg, &args->height);
 	if (!args->cell &&
 	    skip_prefix(&arg, "--cell=") &&
 	    parse_char(arg, &args->cell))
@@ -15,13 +15,73 @@ MAKE_EXT = mk
 # Program sources
 ASCIIGOL = asciigol
 PARSING = parsing
+BITBOARD = bitboard
+KERNEL = kernel
+THREADPOOL = threadpool
+CYCLE = cycle
+FRAMEBUF = framebuf
+SCREEN = screen
+HASHLIFE = hashlife
+PLANE = plane
+RING = ring
+STATS = stats
+RLE = rle
+PRNG = prng
+BATCH = batch
+CENSUS = census
+RULE = rule
 
 # C
 C = gcc
-C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR) -pthread
 
-$(ASCIIGOL): $(APP_DIR)/$(ASCIIGOL).c $(SRC_DIR)/$(ASCIIGOL).c $(OBJ_DIR)/$(PARSING).o
+$(ASCIIGOL): $(APP_DIR)/$(ASCIIGOL).c $(SRC_DIR)/$(ASCIIGOL).c $(OBJ_DIR)/$(PARSING).o $(OBJ_DIR)/$(BITBOARD).o $(OBJ_DIR)/$(KERNEL).o $(OBJ_DIR)/$(THREADPOOL).o $(OBJ_DIR)/$(CYCLE).o $(OBJ_DIR)/$(FRAMEBUF).o $(OBJ_DIR)/$(SCREEN).o $(OBJ_DIR)/$(HASHLIFE).o $(OBJ_DIR)/$(PLANE).o $(OBJ_DIR)/$(RING).o $(OBJ_DIR)/$(STATS).o $(OBJ_DIR)/$(RLE).o $(OBJ_DIR)/$(PRNG).o $(OBJ_DIR)/$(BATCH).o $(OBJ_DIR)/$(CENSUS).o $(OBJ_DIR)/$(RULE).o
 	$(C) $(C_FLAGS) $^ -o $(OUT_DIR)/$@
 
 $(OBJ_DIR)/$(PARSING).o:
 	make -f $(MAKE_DIR)/$(PARSING).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(BITBOARD).o:
+	make -f $(MAKE_DIR)/$(BITBOARD).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(KERNEL).o:
+	make -f $(MAKE_DIR)/$(KERNEL).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(THREADPOOL).o:
+	make -f $(MAKE_DIR)/$(THREADPOOL).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(CYCLE).o:
+	make -f $(MAKE_DIR)/$(CYCLE).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(FRAMEBUF).o:
+	make -f $(MAKE_DIR)/$(FRAMEBUF).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(SCREEN).o:
+	make -f $(MAKE_DIR)/$(SCREEN).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(HASHLIFE).o:
+	make -f $(MAKE_DIR)/$(HASHLIFE).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(PLANE).o:
+	make -f $(MAKE_DIR)/$(PLANE).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(RING).o:
+	make -f $(MAKE_DIR)/$(RING).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(STATS).o:
+	make -f $(MAKE_DIR)/$(STATS).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(RLE).o:
+	make -f $(MAKE_DIR)/$(RLE).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(PRNG).o:
+	make -f $(MAKE_DIR)/$(PRNG).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(BATCH).o:
+	make -f $(MAKE_DIR)/$(BATCH).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(CENSUS).o:
+	make -f $(MAKE_DIR)/$(CENSUS).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(RULE).o:
+	make -f $(MAKE_DIR)/$(RULE).$(MAKE_EXT)
@@ -0,0 +1,38 @@
+# asciigolbench.mk
+# Author: Justin Thoreson
+# Usage:
+# - `make [asciigolbench]`: Builds the benchmark program
+#
+# The sources are compiled together with optimizations rather than linked from
+# the debug objects, so that the timings reflect an optimized build.
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+BENCH_DIR = ./bench
+OUT_DIR = ./bin
+
+# Program sources
+ASCIIGOLBENCH = asciigolbench
+ASCIIGOL = asciigol
+PARSING = parsing
+BITBOARD = bitboard
+KERNEL = kernel
+THREADPOOL = threadpool
+CYCLE = cycle
+FRAMEBUF = framebuf
+SCREEN = screen
+HASHLIFE = hashlife
+PLANE = plane
+RING = ring
+STATS = stats
+RLE = rle
+PRNG = prng
+RULE = rule
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -O2 -I$(INCLUDE_DIR) -pthread
+
+$(ASCIIGOLBENCH): $(BENCH_DIR)/$(ASCIIGOLBENCH).c $(SRC_DIR)/$(ASCIIGOL).c $(SRC_DIR)/$(PARSING).c $(SRC_DIR)/$(BITBOARD).c $(SRC_DIR)/$(KERNEL).c $(SRC_DIR)/$(THREADPOOL).c $(SRC_DIR)/$(CYCLE).c $(SRC_DIR)/$(FRAMEBUF).c $(SRC_DIR)/$(SCREEN).c $(SRC_DIR)/$(HASHLIFE).c $(SRC_DIR)/$(PLANE).c $(SRC_DIR)/$(RING).c $(SRC_DIR)/$(STATS).c $(SRC_DIR)/$(RLE).c $(SRC_DIR)/$(PRNG).c $(SRC_DIR)/$(RULE).c
+	$(C) $(C_FLAGS) $^ -o $(OUT_DIR)/$@
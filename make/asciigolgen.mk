@@ -15,13 +15,25 @@ MAKE_EXT = mk
 # Program sources
 ASCIIGOLGEN = asciigolgen
 PARSING = parsing
+FRAMEBUF = framebuf
+SCREEN = screen
+RLE = rle
 
 # C
 C = gcc
 C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
 
-$(ASCIIGOLGEN): $(APP_DIR)/$(ASCIIGOLGEN).c $(SRC_DIR)/$(ASCIIGOLGEN).c $(OBJ_DIR)/$(PARSING).o
+$(ASCIIGOLGEN): $(APP_DIR)/$(ASCIIGOLGEN).c $(SRC_DIR)/$(ASCIIGOLGEN).c $(OBJ_DIR)/$(PARSING).o $(OBJ_DIR)/$(FRAMEBUF).o $(OBJ_DIR)/$(SCREEN).o $(OBJ_DIR)/$(RLE).o
 	$(C) $(C_FLAGS) $^ -o $(OUT_DIR)/$@
 
 $(OBJ_DIR)/$(PARSING).o:
 	make -f $(MAKE_DIR)/$(PARSING).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(FRAMEBUF).o:
+	make -f $(MAKE_DIR)/$(FRAMEBUF).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(SCREEN).o:
+	make -f $(MAKE_DIR)/$(SCREEN).$(MAKE_EXT)
+
+$(OBJ_DIR)/$(RLE).o:
+	make -f $(MAKE_DIR)/$(RLE).$(MAKE_EXT)
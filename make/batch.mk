@@ -0,0 +1,18 @@
+# batch.mk
+# Author: Justin Thoreson
+# `make [obj/batch.o]`: Build the object file for batch simulation
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+BATCH = batch
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR) -pthread
+
+$(OBJ_DIR)/$(BATCH).o: $(SRC_DIR)/$(BATCH).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# bitboard.mk
+# Author: Justin Thoreson
+# `make [obj/bitboard.o]`: Build the object file for the bit-packed grid
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+BITBOARD = bitboard
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(BITBOARD).o: $(SRC_DIR)/$(BITBOARD).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# census.mk
+# Author: Justin Thoreson
+# `make [obj/census.o]`: Build the object file for the soup census
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+CENSUS = census
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR) -pthread
+
+$(OBJ_DIR)/$(CENSUS).o: $(SRC_DIR)/$(CENSUS).c
+	$(C) $(C_FLAGS) -c $< -o $@
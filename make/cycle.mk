@@ -0,0 +1,18 @@
+# cycle.mk
+# Author: Justin Thoreson
+# `make [obj/cycle.o]`: Build the object file for cycle detection
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+CYCLE = cycle
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(CYCLE).o: $(SRC_DIR)/$(CYCLE).c
+	$(C) $(C_FLAGS) -c $< -o $@
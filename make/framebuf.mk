@@ -0,0 +1,18 @@
+# framebuf.mk
+# Author: Justin Thoreson
+# `make [obj/framebuf.o]`: Build the object file for the frame buffer
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+FRAMEBUF = framebuf
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(FRAMEBUF).o: $(SRC_DIR)/$(FRAMEBUF).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# hashlife.mk
+# Author: Justin Thoreson
+# `make [obj/hashlife.o]`: Build the object file for the hashlife universe
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+HASHLIFE = hashlife
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(HASHLIFE).o: $(SRC_DIR)/$(HASHLIFE).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# kernel.mk
+# Author: Justin Thoreson
+# `make [obj/kernel.o]`: Build the object file for the row stepping kernels
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+KERNEL = kernel
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(KERNEL).o: $(SRC_DIR)/$(KERNEL).c
+	$(C) $(C_FLAGS) -c $< -o $@
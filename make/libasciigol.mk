@@ -0,0 +1,40 @@
+# libasciigol.mk
+# Author: Justin Thoreson
+# Usage:
+# - `make [libasciigol]`: Builds the asciigol engine as a static and a shared
+#   library
+#
+# The sources are compiled as position-independent objects of their own so that
+# both libraries can be built from them.
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+PIC_DIR = $(OBJ_DIR)/pic
+OUT_DIR = ./bin
+
+# Library sources
+LIBASCIIGOL = libasciigol
+SOURCES = asciigol parsing bitboard kernel threadpool cycle framebuf screen hashlife plane ring stats rle prng batch census rule
+OBJECTS = $(SOURCES:%=$(PIC_DIR)/%.o)
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O2 -fPIC -I$(INCLUDE_DIR) -pthread
+AR = ar
+AR_FLAGS = rcs
+
+$(LIBASCIIGOL): $(OUT_DIR)/$(LIBASCIIGOL).a $(OUT_DIR)/$(LIBASCIIGOL).so
+
+$(OUT_DIR)/$(LIBASCIIGOL).a: $(OBJECTS)
+	$(AR) $(AR_FLAGS) $@ $^
+
+$(OUT_DIR)/$(LIBASCIIGOL).so: $(OBJECTS)
+	$(C) $(C_FLAGS) -shared $^ -o $@
+
+$(PIC_DIR)/%.o: $(SRC_DIR)/%.c
+	mkdir -p $(PIC_DIR)
+	$(C) $(C_FLAGS) -c $< -o $@
+
+.PHONY: $(LIBASCIIGOL)
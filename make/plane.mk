@@ -0,0 +1,18 @@
+# plane.mk
+# Author: Justin Thoreson
+# `make [obj/plane.o]`: Build the object file for the unbounded plane
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+PLANE = plane
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(PLANE).o: $(SRC_DIR)/$(PLANE).c
+	$(C) $(C_FLAGS) -c $< -o $@
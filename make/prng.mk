@@ -0,0 +1,18 @@
+# prng.mk
+# Author: Justin Thoreson
+# `make [obj/prng.o]`: Build the object file for seeded random soups
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+PRNG = prng
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(PRNG).o: $(SRC_DIR)/$(PRNG).c
+	$(C) $(C_FLAGS) -c $< -o $@
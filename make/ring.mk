@@ -0,0 +1,18 @@
+# ring.mk
+# Author: Justin Thoreson
+# `make [obj/ring.o]`: Build the object file for the ring of frames
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+RING = ring
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR) -pthread
+
+$(OBJ_DIR)/$(RING).o: $(SRC_DIR)/$(RING).c
+	$(C) $(C_FLAGS) -c $< -o $@
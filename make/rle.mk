@@ -0,0 +1,18 @@
+# rle.mk
+# Author: Justin Thoreson
+# `make [obj/rle.o]`: Build the object file for run-length encoded patterns
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+RLE = rle
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(RLE).o: $(SRC_DIR)/$(RLE).c
+	$(C) $(C_FLAGS) -c $< -o $@
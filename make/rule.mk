@@ -0,0 +1,18 @@
+# rule.mk
+# Author: Justin Thoreson
+# `make [obj/rule.o]`: Build the object file for the rule strings
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+RULE = rule
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(RULE).o: $(SRC_DIR)/$(RULE).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# screen.mk
+# Author: Justin Thoreson
+# `make [obj/screen.o]`: Build the object file for the differential screen renderer
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+SCREEN = screen
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(SCREEN).o: $(SRC_DIR)/$(SCREEN).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# stats.mk
+# Author: Justin Thoreson
+# `make [obj/stats.o]`: Build the object file for the phase timers
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+STATS = stats
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR)
+
+$(OBJ_DIR)/$(STATS).o: $(SRC_DIR)/$(STATS).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,18 @@
+# threadpool.mk
+# Author: Justin Thoreson
+# `make [obj/threadpool.o]`: Build the object file for the thread pool
+
+# Directories
+INCLUDE_DIR = ./include
+SRC_DIR = ./src
+OBJ_DIR = ./obj
+
+# Program sources
+THREADPOOL = threadpool
+
+# C
+C = gcc
+C_FLAGS = -std=gnu11 -Wall -Werror -pedantic -ggdb -O0 -I$(INCLUDE_DIR) -pthread
+
+$(OBJ_DIR)/$(THREADPOOL).o: $(SRC_DIR)/$(THREADPOOL).c
+	$(C) $(C_FLAGS) -c $< -o $@
@@ -0,0 +1,32 @@
+#!/bin/bash
+# Run this from the root of the project
+#
+# Checks that oscillators are detected exactly at the max-period boundary:
+# with max-period equal to their period they cycle, and with one less they
+# are never detected.
+
+CONFIG_DIR="./config"
+ASCIIGOL="asciigol"
+ASCIIGOL_BIN="./bin/$ASCIIGOL"
+FAILED=0
+
+if [ ! -f "$ASCIIGOL_BIN" ]; then
+	make $ASCIIGOL
+fi
+
+# <config> <period> <generations>
+check_boundary() {
+	local FILE="$CONFIG_DIR/$1.asciigol"
+	local AT=$($ASCIIGOL_BIN --headless --file=$FILE --max-period=$2 --generations=$3 | tail -n 1)
+	local BELOW=$($ASCIIGOL_BIN --headless --file=$FILE --max-period=$(($2 - 1)) --generations=$3 | tail -n 1)
+	echo -e "$FILE\n\tmax-period $2: $AT\n\tmax-period $(($2 - 1)): $BELOW"
+	if [[ "$AT" != *"ASCIIGOL_CYCLED"*"period $2 "* || "$BELOW" != *"ASCIIGOL_OK"* ]]; then
+		echo -e "\tFAILED"
+		FAILED=1
+	fi
+}
+
+check_boundary blinker 2 20
+check_boundary gosper_glider_gun 60 2000
+
+exit $FAILED
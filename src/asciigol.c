@@ -6,31 +6,175 @@
  */
 
 #include <asciigol.h>
+#include <bitboard.h>
+#include <cycle.h>
+#include <hashlife.h>
+#include <kernel.h>
+#include <plane.h>
+#include <prng.h>
+#include <ring.h>
+#include <rle.h>
+#include <rule.h>
+#include <screen.h>
+#include <stats.h>
+#include <threadpool.h>
+#include <errno.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /**
  * @brief The data type representing a Game of Life cell.
  */
 typedef uint8_t cell_t;
 
+/**
+ * @brief The number of ghost cells padding each row and column of the byte
+ *        grid: a one-cell halo on either side.
+ */
+#define HALO_CELLS 2
+
+/**
+ * @brief The number of rows of cells making up a tile of the byte grid.
+ */
+#define TILE_ROWS 16
+
+/**
+ * @brief The number of columns of cells making up a tile of the byte grid.
+ */
+#define TILE_COLS 64
+
+/**
+ * @brief The outcome of computing one band of rows of a generation.
+ */
+typedef struct {
+	asciigol_result_t result;
+	uint64_t hash;
+} band_t;
+
+/**
+ * @brief The Game of Life grid as stored by the selected backend.
+ *
+ * The byte backend stores one cell per byte in `cells` and `back_buffer`,
+ * surrounded by a one-cell halo of ghost cells (see `cell_index`), and only
+ * computes the tiles of `TILE_ROWS` by `TILE_COLS` cells flagged in
+ * `active_tiles`: those that changed in the previous generation, or that
+ * neighbor one that did. The tiles that change are flagged in `changed_tiles`
+ * and rehashed into `tile_hashes`, whose sum is the hash of their band. The
+ * bitboard backend stores 64 cells per word in `board` and `back_board`,
+ * unpacking a single row into `row_buffer` when rendering. Either backend
+ * splits each generation into horizontal bands of rows that are computed by
+ * `pool`, each band reporting into `bands`. The hashlife backend instead
+ * holds an unbounded `universe`, of which the grid is only the viewport, and
+ * the plane backend an unbounded `plane` of chunks, of which the grid is a
+ * viewport whose top-left cell lies at `view_x`, `view_y`. A random initial
+ * state is generated from `seed`. Every backend computes the generations
+ * under `rule`, which the byte backend compiles into `kernel`. The hash of
+ * every generation is recorded in `history`, numbered from `history_offset`,
+ * to detect cycles, and each rendered generation is captured into `frames`,
+ * from which the render thread draws it to `screen`, which only repaints the
+ * cells that changed.
+ */
+typedef struct {
+	asciigol_backend_t backend;
+	uint32_t width;
+	uint32_t height;
+	bool wrap;
+	cell_t* cells;
+	cell_t* back_buffer;
+	rule_t rule;
+	kernel_t kernel;
+	uint32_t tile_cols;
+	uint32_t tile_rows;
+	bool* active_tiles;
+	bool* changed_tiles;
+	uint64_t* tile_hashes;
+	bitboard_t board;
+	bitboard_t back_board;
+	hashlife_t universe;
+	plane_t plane;
+	int64_t view_x;
+	int64_t view_y;
+	cell_t* row_buffer;
+	threadpool_t pool;
+	band_t* bands;
+	cycle_detector_t history;
+	uint64_t history_offset;
+	uint64_t seed;
+	uint64_t generation;
+	uint32_t period;
+	uint64_t cycle_start;
+	ring_t frames;
+	screen_t screen;
+} grid_t;
+
+/**
+ * @brief The thread rendering the generations captured from the Game of Life
+ *        grid.
+ *
+ * The renderer draws each frame of the grid at the pace set by `delay`,
+ * counting the frames that missed their deadline, while the grid computes the
+ * following generations. The time spent rendering and waiting is recorded into
+ * `stats`.
+ */
+typedef struct {
+	grid_t* grid;
+	stats_t* stats;
+	pthread_t thread;
+	uint16_t delay;
+	char state_chars[RULE_MAX_STATES];
+	asciigol_bg_t background;
+	uint64_t missed_deadlines;
+} renderer_t;
+
+/**
+ * @brief A Game of Life grid driven through the engine API.
+ *
+ * The grid is allocated on its own, as its pool of threads must not move in
+ * memory, so that loading a pattern can build the new grid before destroying
+ * the old one. `args` keeps the configuration applied to every grid loaded.
+ */
+struct asciigol_engine {
+	grid_t* grid;
+	asciigol_args_t args;
+};
+
 /**
  * @brief The default width of the Game of Life grid.
  */
-static const uint8_t DEFAULT_WIDTH = 100;
+static const uint32_t DEFAULT_WIDTH = 100;
 
 /**
  * @brief The default height of the Game of Life grid.
  */
-static const uint8_t DEFAULT_HEIGHT = 40;
+static const uint32_t DEFAULT_HEIGHT = 40;
 
 /**
  * @brief The default delay between frames in milliseconds.
  */
 static const uint16_t DEFAULT_DELAY_MILLIS = 50;
 
+/**
+ * @brief The default percentage of live cells in a random initial state.
+ */
+static const uint8_t DEFAULT_DENSITY_PERCENT = 50;
+
+/**
+ * @brief The default longest period of cycles that are detected.
+ */
+static const uint16_t DEFAULT_MAX_PERIOD = 64;
+
+/**
+ * @brief The number of generations that can be captured ahead of the one being
+ *        rendered.
+ */
+static const uint32_t NUM_FRAMES = 4;
+
 /**
  * @brief The number of milliseconds per second
  */
@@ -41,6 +185,34 @@ static const uint16_t MILLIS_PER_SECOND = 1000;
  */
 static const uint32_t NANOS_PER_MILLI = 1000000;
 
+/**
+ * @brief The constant first line of a configuration file.
+ */
+static const char CONFIG_HEADER[] = "asciigol\n";
+
+/**
+ * @brief The number of bytes a configuration file that cannot be mapped is
+ *        read in at once.
+ */
+static const size_t READ_BLOCK_SIZE = 1 << 20;
+
+/**
+ * @brief The character `0` repeated in each byte of a word, mapping the
+ *        characters `0` and `1` of eight cells to zero and one.
+ */
+static const uint64_t ZERO_CHARS = 0x3030303030303030ULL;
+
+/**
+ * @brief The bits of each byte of a word that are clear in a cell.
+ */
+static const uint64_t NON_CELL_BITS = 0xFEFEFEFEFEFEFEFEULL;
+
+/**
+ * @brief Multiplier gathering the low bit of each byte of a word into the top
+ *        byte, the bit of byte i landing in bit 56 + i.
+ */
+static const uint64_t GATHER_BITS = 0x0102040810204080ULL;
+
 /**
  * @brief The default character representing a live cell.
  */
@@ -52,19 +224,30 @@ static const char DEFAULT_LIVE_CHAR = '#';
 static const char DEFAULT_DEAD_CHAR = ' ';
 
 /**
- * @brief ANSI control code for white background with black foreground.
+ * @brief The characters representing the dying states of a Generations rule,
+ *        from the state following the live one to the last.
  */
-static const char* BG_WHITE_FG_BLACK = "\x1b[47;30m";
+static const char DECAY_CHARS[] = "*+=-:.";
 
 /**
- * @brief ANSI control code for black background with white foreground.
+ * @brief Colors of the rendered cells, indexing into `PALETTE`.
  */
-static const char* BG_BLACK_FG_WHITE = "\x1b[40;37m";
+typedef enum {
+	BG_DEFAULT_FG_DEFAULT,
+	BG_WHITE_FG_BLACK,
+	BG_BLACK_FG_WHITE
+} color_t;
 
 /**
- * @brief ANSI control code to reset terminal attributes (colors) to default.
+ * @brief ANSI control codes of each color: reset terminal attributes (colors)
+ *        to default, white background with black foreground, and black
+ *        background with white foreground.
  */
-static const char* BG_DEFAULT_FG_DEFAULT = "\x1b[0m";
+static const char* const PALETTE[] = {
+	"\x1b[0m",
+	"\x1b[47;30m",
+	"\x1b[40;37m"
+};
 
 /**
  * @brief Clear the contents of the terminal screen.
@@ -72,15 +255,27 @@ static const char* BG_DEFAULT_FG_DEFAULT = "\x1b[0m";
 static void clear_screen();
 
 /**
- * @brief Reset the cursor to the top-left position.
+ * @brief Allocate and initialize a Game of Life grid without a screen.
+ * @param[out] grid The allocated grid.
+ * @param[in] args The arguments configuring the grid.
+ * @return The result of the initialization.
+ */
+static asciigol_result_t create_grid(grid_t** const grid, asciigol_args_t args);
+
+/**
+ * @brief Move the deadline of a frame one frame period later.
+ * @param[in,out] deadline The deadline, on the monotonic clock.
+ * @param[in] delay The period of a frame in milliseconds, or zero for the
+ *                  default.
  */
-static void reset_cursor();
+static void advance_deadline(struct timespec* const deadline, const uint16_t delay);
 
 /**
- * @brief Pause execution for a provided number of milliseconds.
- * @param[in] delay The number of milliseconds to sleep for.
+ * @brief Pause execution until a deadline.
+ * @param[in] deadline The deadline, on the monotonic clock.
+ * @return True if the deadline was met, false if it had already passed.
  */
-static void wait(const uint16_t delay);
+static bool wait(const struct timespec* const deadline);
 
 /**
  * @brief Deallocate a provided heap-allocated buffer.
@@ -89,130 +284,250 @@ static void wait(const uint16_t delay);
 static void free_buffer(cell_t** buffer);
 
 /**
- * @brief Initialize the Game of Life cells from a provided file.
- * @param[out] cells The cells comprising the Game of Life grid.
+ * @brief Compute the number of cells in a grid, including its halo of ghost
+ *        cells, guarding against overflow.
+ * @param[in] width The width of the Game of Life grid.
+ * @param[in] height The height of the Game of Life grid.
+ * @param[out] size The number of cells in the padded grid.
+ * @return True if the size is nonzero and representable, false otherwise.
+ */
+static bool compute_padded_size(const uint32_t width, const uint32_t height, size_t* const size);
+
+/**
+ * @brief Compute the index of a cell within the padded grid.
+ *
+ * The grid is stored with a one-cell halo around the field, so row -1,
+ * row `height`, column -1 and column `width` are valid ghost cells that hold
+ * either dead cells or, when wrapping, copies of the opposite edges.
+ *
+ * @param[in] width The width of the Game of Life grid.
+ * @param[in] row The row of the cell, where -1 denotes the top halo.
+ * @param[in] col The column of the cell, where -1 denotes the left halo.
+ * @return The index of the cell.
+ */
+static size_t cell_index(const uint32_t width, const int64_t row, const int64_t col);
+
+/**
+ * @brief A random initial state being filled by the pool of threads.
+ */
+typedef struct {
+	cell_t* cells;
+	bitboard_t* board;
+	uint32_t width;
+	uint32_t height;
+	uint64_t seed;
+	uint32_t probability;
+} soup_t;
+
+/**
+ * @brief Initialize the Game of Life cells from a provided file, either an
+ *        asciigol configuration file or a run-length encoded pattern.
+ *
+ * A configuration file is mapped into memory, or read in large blocks if it
+ * cannot be, and converted row by row straight into the cells, or into the
+ * bitboard if one is given.
+ *
+ * @param[out] cells The cells comprising the Game of Life grid, left
+ *                   unallocated if the bitboard was initialized instead.
+ * @param[out] board The bitboard to pack a configuration file into, or NULL
+ *                   to initialize the cells.
  * @param[out] width The width of the Game of Life grid.
  * @param[out] height The height of the Game of Life grid.
+ * @param[out] rule The rule of the Game of Life grid, left unchanged unless
+ *                  the file names one.
  * @param[in] filename The name of the file to initialize the cells from.
  * @return The result of the initialization.
  */
 static asciigol_result_t init_cells_from_file(
 	cell_t** cells,
-	uint8_t* const width,
-	uint8_t* const height,
+	bitboard_t* const board,
+	uint32_t* const width,
+	uint32_t* const height,
+	rule_t* const rule,
 	char* const filename
 );
 
 /**
- * @brief Initialize the Game of Life cells at random.
- * @param[out] cells The cells comprising the Game of Life grid.
+ * @brief Load the contents of a file into memory, mapping it if possible and
+ *        reading it in blocks otherwise.
+ * @param[in] file The file to load, positioned at its start.
+ * @param[out] data The contents of the file, or NULL if it is empty.
+ * @param[out] size The size of the file in bytes.
+ * @param[out] is_mapped Whether the contents are mapped rather than allocated.
+ * @return True if the file was loaded, false otherwise.
+ */
+static bool load_file(FILE* const file, char** const data, size_t* const size, bool* const is_mapped);
+
+/**
+ * @brief Release the contents of a file loaded into memory.
+ * @param[in] data The contents of the file.
+ * @param[in] size The size of the file in bytes.
+ * @param[in] is_mapped Whether the contents are mapped rather than allocated.
+ */
+static void unload_file(char* const data, const size_t size, const bool is_mapped);
+
+/**
+ * @brief Validate and convert a row of a configuration file.
+ *
+ * The errors are those of reading the row character by character: a
+ * character other than `0`, `1` or the newline ending the row is a bad cell,
+ * unless it is a `0` or `1` beyond the width, and a row ending before the
+ * width or lacking its newline has a bad dimension.
+ *
+ * @param[in,out] cursor The start of the row, moved past its newline.
+ * @param[in] end The end of the configuration file.
  * @param[in] width The width of the Game of Life grid.
- * @param[in] height The height of the Game of Life grid.
- * @return The result of the initialization.
+ * @param[out] cells The cells of the row, or NULL to pack them instead.
+ * @param[out] words The words of the row of a bitboard, if the cells are NULL.
+ * @return The result of the conversion.
  */
-static asciigol_result_t init_cells_at_random(
-	cell_t** cells,
-	uint8_t* const width,
-	uint8_t* const height
+static asciigol_result_t parse_row(
+	const char** const cursor,
+	const char* const end,
+	const uint32_t width,
+	cell_t* const cells,
+	uint64_t* const words
 );
 
 /**
- * @brief Initialize the back-buffer for the Game of Life cells.
- * @param[out] back_buffer The back-buffer for the Game of Life cells.
- * @param[in] size The size that should be allocated.
+ * @brief Convert the characters of a row into cells, eight at a time.
+ * @param[in] chars The characters of the row.
+ * @param[in] width The width of the Game of Life grid.
+ * @param[out] cells The cells of the row.
+ * @return True if every character was a `0` or `1`, false otherwise.
+ */
+static bool convert_chars(const char* const chars, const uint32_t width, cell_t* const cells);
+
+/**
+ * @brief Pack the characters of a row into the words of a bitboard row, eight
+ *        at a time.
+ * @param[in] chars The characters of the row.
+ * @param[in] width The width of the Game of Life grid.
+ * @param[out] words The words of the row.
+ * @return True if every character was a `0` or `1`, false otherwise.
+ */
+static bool pack_chars(const char* const chars, const uint32_t width, uint64_t* const words);
+
+/**
+ * @brief Initialize the Game of Life cells from a run-length encoded pattern.
+ * @param[out] cells The cells comprising the Game of Life grid.
+ * @param[out] width The width of the Game of Life grid.
+ * @param[out] height The height of the Game of Life grid.
+ * @param[out] rule The rule of the Game of Life grid, left unchanged unless
+ *                  the header names one.
+ * @param[in,out] file The file holding the pattern, positioned at its start.
  * @return The result of the initialization.
  */
-static asciigol_result_t init_back_buffer(
-	cell_t** back_buffer,
-	const uint16_t size
+static asciigol_result_t init_cells_from_rle(
+	cell_t** cells,
+	uint32_t* const width,
+	uint32_t* const height,
+	rule_t* const rule,
+	FILE* const file
 );
 
 /**
- * @brief Initialize the Game of Life cells.
- * @param[out] cells The cells comprising the Game of Life grid.
- * @param[out] back_buffer The back-buffer for the Game of Life cells.
- * @param[in] width The width of the Game of Life grid.
- * @param[in] height The height of the Game of Life grid.
+ * @brief Initialize the Game of Life cells at random.
+ *
+ * Each row is generated from its own stream of the seed, 64 cells per random
+ * word, so the bands of rows are filled in parallel by the pool while the
+ * cells only depend on the seed and density.
+ *
+ * @param[out] cells The cells comprising the Game of Life grid, left
+ *                   unallocated if the bitboard was initialized instead.
+ * @param[out] board The bitboard to fill, or NULL to initialize the cells.
+ * @param[in,out] pool The pool of threads filling the rows.
+ * @param[in,out] width The width of the Game of Life grid, zero denoting the
+ *                      default.
+ * @param[in,out] height The height of the Game of Life grid, zero denoting
+ *                       the default.
+ * @param[in] seed The seed of the random cells.
+ * @param[in] density The percentage of live cells, zero denoting the default.
  * @return The result of the initialization.
  */
-static asciigol_result_t init_cells(
+static asciigol_result_t init_cells_at_random(
 	cell_t** cells,
-	cell_t** back_buffer,
-	uint8_t* const width,
-	uint8_t* const height,
-	char* const filename
+	bitboard_t* const board,
+	threadpool_t* const pool,
+	uint32_t* const width,
+	uint32_t* const height,
+	const uint64_t seed,
+	const uint8_t density
 );
 
 /**
- * @brief Count the number of live neighbors surrounding a cell.
- * @param[in] cells The cells in the Game of Life grid.
- * @param[in] row The row of the cell to count the neighbors of.
- * @param[in] col The column of the cell to count the neighbors of.
+ * @brief Fill the Game of Life cells at random.
+ * @param[out] cells The cells comprising the Game of Life grid, if the
+ *                   bitboard is NULL.
+ * @param[out] board The bitboard to fill, or NULL to fill the cells.
+ * @param[in,out] pool The pool of threads filling the rows.
  * @param[in] width The width of the Game of Life grid.
  * @param[in] height The height of the Game of Life grid.
- * @param[in] wrap Specify whether, if the cell is residing on an edge of the
- *                 grid, to count the neighbors along the opposite edge of said
- *                 cell, wrapping around as if both edges were connected.
- * @return The number of live neighbors surrounding the specified cell.
+ * @param[in] seed The seed of the random cells.
+ * @param[in] density The percentage of live cells, zero denoting the default.
  */
-static uint8_t count_live_neighbors(
+static void fill_soup(
 	cell_t* const cells,
-	const uint8_t row,
-	const uint8_t col,
-	const uint8_t width,
-	const uint8_t height,
-	const bool wrap
+	bitboard_t* const board,
+	threadpool_t* const pool,
+	const uint32_t width,
+	const uint32_t height,
+	const uint64_t seed,
+	const uint8_t density
 );
 
 /**
- * @brief Determine if a cell should live or die.
- * @param[in] cell A cell in the Game of Life grid.
- * @param[in] num_live_neighbors The number of living cells neighboring the
- *                               given cell.
- * @return The new value of the provided cell: live or dead.
+ * @brief Fill one band of the rows of a random initial state.
+ * @param[in,out] context The soup being filled.
+ * @param[in] band The index of the band.
+ * @param[in] num_bands The number of bands the rows are split into.
  */
-static cell_t compute_game_of_life(
-	const cell_t cell,
-	const uint8_t num_live_neighbors
-);
+static void fill_soup_band(void* context, const uint32_t band, const uint32_t num_bands);
 
 /**
- * @brief Compute the new value of a cell.
- * @param[in] cells The cells comprising the Game of Life grid.
- * @param[in] row The row of the cell to recompute.
- * @param[in] col The column of the cell to recompute.
- * @param[in] width The width of the Game of Life grid.
- * @param[in] height The height of the Game of Life grid.
- * @param[in] wrap Specify whether, if the cell is residing on an edge of the
- *                 grid, to count the neighbors along the opposite edge of said
- *                 cell, wrapping around as if both edges were connected.
- * @return The new value of the specified cell.
+ * @brief Pick a seed for a random initial state from the clock.
+ * @return The seed, which is never zero.
  */
-static cell_t compute_cell(
-	cell_t* const cells,
-	const uint8_t row,
-	const uint8_t col,
-	const uint8_t width,
-	const uint8_t height,
-	const bool wrap
+static uint64_t pick_seed();
+
+/**
+ * @brief Initialize the back-buffer for the Game of Life cells.
+ * @param[out] back_buffer The back-buffer for the Game of Life cells.
+ * @param[in] size The size that should be allocated.
+ * @return The result of the initialization.
+ */
+static asciigol_result_t init_back_buffer(
+	cell_t** back_buffer,
+	const size_t size
 );
 
 /**
- * @brief Compute the next iteration of cells.
- * @param[in] cells The cells comprising the Game of Life grid.
- * @param[out] new_cells The newly-computed cells of the Game of Life grid.
+ * @brief Initialize the Game of Life cells from a file or at random, along
+ *        with their back-buffer.
+ *
+ * With the bitboard backend, the cells are packed straight into the bitboard
+ * instead where possible.
+ *
+ * @param[in,out] grid The Game of Life grid, whose pool of threads is used.
+ * @param[in,out] args The arguments configuring the grid. The width and
+ *                     height are updated to the dimensions in use.
+ * @return The result of the initialization.
+ */
+static asciigol_result_t init_cells(grid_t* const grid, asciigol_args_t* const args);
+
+/**
+ * @brief Fill the halo of ghost cells surrounding the Game of Life grid.
+ * @param[in,out] cells The cells comprising the padded Game of Life grid.
  * @param[in] width The width of the Game of Life grid.
  * @param[in] height The height of the Game of Life grid.
- * @param[in] wrap Specify whether, if the cell is residing on an edge of the
- *                 grid, to count the neighbors along the opposite edge of said
- *                 cell, wrapping around as if both edges were connected.
- * @return The result of computing the next Game of Life iteration.
+ * @param[in] wrap Specify whether the halo mirrors the opposite edges of the
+ *                 grid, wrapping around as if both edges were connected, or
+ *                 holds dead cells.
  */
-static asciigol_result_t compute_cells(
-	cell_t* cells,
-	cell_t* new_cells,
-	const uint8_t width,
-	const uint8_t height,
+static void fill_halo(
+	cell_t* const cells,
+	const uint32_t width,
+	const uint32_t height,
 	const bool wrap
 );
 
@@ -223,24 +538,6 @@ static asciigol_result_t compute_cells(
  */
 static void swap_buffers(cell_t** buffer_a, cell_t** buffer_b);
 
-/**
- * @brief Render the Game of Life cells.
- * @param[in] cells The cells comprising the Game of Life grid.
- * @param[in] width The width of the Game of Life grid.
- * @param[in] height The height of the Game of Life grid.
- * @param[in] live_char The character to render for a live cell.
- * @param[in] dead_char The character to render for a dead cell.
- * @param[in] background The background color type.
- */
-static void render_cells(
-	cell_t* cells,
-	const uint8_t width,
-	const uint8_t height,
-	const char live_char,
-	const char dead_char,
-	const asciigol_bg_t background
-);
-
 /**
  * @brief Deallocate the Game of Life buffers.
  * @param[in] cells The active buffer containing the Game of Life cells.
@@ -248,163 +545,728 @@ static void render_cells(
  */
 static void destroy_cells(cell_t** cells, cell_t** back_buffer);
 
-asciigol_result_t asciigol(asciigol_args_t args) {
-	cell_t* cells = NULL;
-	cell_t* back_buffer = NULL;
-	asciigol_result_t result = init_cells(&cells, &back_buffer, &args.width, &args.height, args.filename);
-	if (result != ASCIIGOL_OK)
-		return result;
-	clear_screen();
-	while (result != ASCIIGOL_CONVERGED) {
-		reset_cursor();
-		render_cells(cells, args.width, args.height, args.live_char, args.dead_char, args.background);
-		result = compute_cells(cells, back_buffer, args.width, args.height, args.wrap);
-		swap_buffers(&cells, &back_buffer);
-		wait(args.delay);
-	}
-	destroy_cells(&cells, &back_buffer);
-	return result;
-}
+/**
+ * @brief Initialize the Game of Life grid for the selected backend.
+ * @param[out] grid The Game of Life grid to initialize.
+ * @param[in,out] args The arguments configuring the grid. The width and
+ *                     height are updated to the dimensions in use.
+ * @return The result of the initialization.
+ */
+static asciigol_result_t init_grid(grid_t* const grid, asciigol_args_t* const args);
 
-static void clear_screen() {
-	printf("\x1b[2J");
-}
+/**
+ * @brief Pack the Game of Life cells into the bitboards, unless they were
+ *        packed straight from a configuration file or generated into them.
+ * @param[in,out] grid The Game of Life grid whose byte buffers are packed and
+ *                     then deallocated.
+ * @return The result of the conversion.
+ */
+static asciigol_result_t init_bitboards(grid_t* const grid);
 
-static void reset_cursor() {
-	printf("\x1b[H");
-}
+/**
+ * @brief Build the Game of Life universe from the Game of Life cells.
+ * @param[in,out] grid The Game of Life grid whose byte buffers are built from
+ *                     and then deallocated.
+ * @return The result of the conversion.
+ */
+static asciigol_result_t init_universe(grid_t* const grid);
 
-static void wait(const uint16_t delay) {
-	const uint8_t seconds =  delay ? delay / MILLIS_PER_SECOND : 0;
-	const uint32_t nanoseconds =  NANOS_PER_MILLI *
-		(delay ? delay % MILLIS_PER_SECOND : DEFAULT_DELAY_MILLIS);
-	struct timespec req =  { seconds, nanoseconds };
-	nanosleep(&req, NULL);
-}
+/**
+ * @brief Build the Game of Life plane from the Game of Life cells.
+ * @param[in,out] grid The Game of Life grid.
+ * @return The result of building the plane.
+ */
+static asciigol_result_t init_plane(grid_t* const grid);
 
-static void free_buffer(cell_t** buffer) {
-	if (*buffer) {
-		free(*buffer);
-		*buffer = NULL;
-	}
-}
+/**
+ * @brief Allocate the tiles of the byte grid, all of which are active in the
+ *        first generation.
+ * @param[in,out] grid The Game of Life grid.
+ * @return The result of the allocation.
+ */
+static asciigol_result_t init_tiles(grid_t* const grid);
 
-static asciigol_result_t init_cells_from_file(
-	cell_t** cells,
-	uint8_t* const width,
-	uint8_t* const height,
-	char* const filename
-) {
-	char character;
-	int64_t temp_width, temp_height;
-	uint16_t size, index = 0;
-	uint8_t row = 0, col = 0;
-	char* line = NULL;
-	size_t line_len = 0;
-	asciigol_result_t result = ASCIIGOL_OK;
-	FILE* file = fopen(filename, "r");
+/**
+ * @brief Spawn the pool of threads that computes the Game of Life grid.
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] threads The number of threads to compute with, zero denoting
+ *                    a single thread. The hashlife and plane backends are
+ *                    computed on the calling thread alone, so no thread is
+ *                    spawned for them.
+ * @return The result of the initialization.
+ */
+static asciigol_result_t init_pool(grid_t* const grid, const uint16_t threads);
 
-	/****************************************
-	 * read constant first line: "asciigol" *
-	 ****************************************/
+/**
+ * @brief Initialize the history of generations used to detect cycles, and
+ *        record the initial generation.
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] max_period The longest period to detect, zero denoting the
+ *                       default.
+ * @return The result of the initialization.
+ */
+static asciigol_result_t init_history(grid_t* const grid, const uint16_t max_period);
 
-	if (!file) {
-		result = ASCIIGOL_BAD_FILE;
-		goto EXIT;
-	}
-	if (getline(&line, &line_len, file) <= 0) {
-		result = ASCIIGOL_BAD_HEADER;
-		goto EXIT;
-	}
-	if (strcmp(line, "asciigol\n")) {
-		result = ASCIIGOL_BAD_HEADER;
-		goto EXIT;
-	}
+/**
+ * @brief Record the hash of the initial generation into the history of
+ *        generations, rehashing every tile of the byte grid.
+ * @param[in,out] grid The Game of Life grid.
+ */
+static void record_initial_generation(grid_t* const grid);
 
-	/*************************
-	 * read width and height *
-	 *************************/
+/**
+ * @brief Replace the cells of a random Game of Life grid with those of another
+ *        seed, reusing its buffers, and start its generations over.
+ * @param[in,out] grid The Game of Life grid, stored by the byte or bitboard
+ *                     backend.
+ * @param[in] seed The seed of the random cells.
+ * @param[in] density The percentage of live cells, zero denoting the default.
+ */
+static void reseed_grid(grid_t* const grid, const uint64_t seed, const uint8_t density);
 
-	free(line);
-	line = NULL;
-	if (getline(&line, &line_len, file) <= 0) {
-		result = ASCIIGOL_BAD_DIMENSION;
-		goto EXIT;
-	}
-	if (sscanf(line, "%ld,%ld", &temp_width, &temp_height) < 2) {
-		result = ASCIIGOL_BAD_DIMENSION;
-		goto EXIT;
-	}
-	if (temp_width <= 0 || temp_width > UINT8_MAX || temp_height <= 0 || temp_height > UINT8_MAX) {
-		result = ASCIIGOL_BAD_DIMENSION;
-		goto EXIT;
-	}
-	*width = (uint8_t)temp_width;
-	*height = (uint8_t)temp_height;
+/**
+ * @brief Allocate the screen the Game of Life grid is rendered to, along with
+ *        the ring of frames handed to the render thread.
+ * @param[in,out] grid The Game of Life grid.
+ * @return The result of the allocation.
+ */
+static asciigol_result_t init_screen(grid_t* const grid);
 
-	/****************************
-	 * read initial cell states *
-	 ****************************/
+/**
+ * @brief Compute the rows making up one band of the Game of Life grid.
+ * @param[in] grid The Game of Life grid.
+ * @param[in] band The index of the band.
+ * @param[in] num_bands The number of bands the grid is split into.
+ * @param[out] row_begin The first row of the band.
+ * @param[out] row_end One past the last row of the band.
+ */
+static void get_band_rows(
+	const grid_t* const grid,
+	const uint32_t band,
+	const uint32_t num_bands,
+	uint32_t* const row_begin,
+	uint32_t* const row_end
+);
 
-	size = (uint16_t)(*width * *height);
-	*cells = (cell_t*)malloc(size);
-	if (!cells) {
-		result = ASCIIGOL_BAD_DIMENSION;
-		goto EXIT;
-	}
+/**
+ * @brief Hash a band of rows of the Game of Life bitboards.
+ * @param[in] grid The Game of Life grid.
+ * @param[in] back Specify whether to hash the back-buffer rather than the
+ *                 active buffer.
+ * @param[in] row_begin The first row of the band.
+ * @param[in] row_end One past the last row of the band.
+ * @return The hash of the band.
+ */
+static uint64_t hash_rows(
+	const grid_t* const grid,
+	const bool back,
+	const uint32_t row_begin,
+	const uint32_t row_end
+);
 
-	// iterate through remaining characters of file
-	while((character = getc(file)) != EOF) {
+/**
+ * @brief Combine the hashes of every band into the hash of a generation.
+ * @param[in] grid The Game of Life grid whose bands have been hashed.
+ * @return The hash of the generation.
+ */
+static uint64_t combine_band_hashes(const grid_t* const grid);
 
-		// error if number of rows greater than specified height
-		if (row >= *height) {
-			result = ASCIIGOL_BAD_DIMENSION;
-			goto EXIT;
-		}
+/**
+ * @brief Record the hash of the latest generation, detecting cycles.
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] hash The hash of the generation.
+ * @param[in] result The result of computing the generation.
+ * @return The result of computing the generation, accounting for cycles.
+ */
+static asciigol_result_t record_generation(
+	grid_t* const grid,
+	const uint64_t hash,
+	asciigol_result_t result
+);
 
-		// reached end of row
-		if (character == '\n') {
-			// error if number of columns less than specified width
-			if (col < *width) {
-				result = ASCIIGOL_BAD_DIMENSION;
-				goto EXIT;
-			}
-			row++;
-			col = 0;
-			continue;
-		}
+/**
+ * @brief Hash a tile of the byte grid.
+ * @param[in] grid The Game of Life grid.
+ * @param[in] cells The buffer of cells to hash.
+ * @param[in] tile_row The row of the tile.
+ * @param[in] tile_col The column of the tile.
+ * @return The hash of the tile, which also depends on its position.
+ */
+static uint64_t hash_tile(
+	const grid_t* const grid,
+	const cell_t* const cells,
+	const uint32_t tile_row,
+	const uint32_t tile_col
+);
 
-		// error if cell is not '0' or '1'
-		if (character != '0' && character != '1') {
-			result = ASCIIGOL_BAD_CELL;
-			goto EXIT;
-		}
+/**
+ * @brief Compute the next iteration of a tile of the byte grid.
+ *
+ * The halo must already be filled; tiles that do not overlap may be computed
+ * concurrently.
+ *
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] tile_row The row of the tile.
+ * @param[in] tile_col The column of the tile.
+ * @return True if any cell of the tile changed, false otherwise.
+ */
+static bool compute_tile(grid_t* const grid, const uint32_t tile_row, const uint32_t tile_col);
 
-		// error if number of columns greater than specified width
-		if (++col > *width) {
-			result = ASCIIGOL_BAD_DIMENSION;
-			goto EXIT;
-		}
+/**
+ * @brief Compute the next iteration of the active tiles of a band of the byte
+ *        grid, rehashing those that changed.
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] band The index of the band.
+ * @param[in] row_begin The first row of the band, at the start of a tile.
+ * @param[in] row_end One past the last row of the band.
+ * @return The result of computing the next Game of Life iteration of the band.
+ */
+static asciigol_result_t compute_tiles(
+	grid_t* const grid,
+	const uint32_t band,
+	const uint32_t row_begin,
+	const uint32_t row_end
+);
 
-		// convert '0' or '1' to cell/integer representation
-		(*cells)[index++] = character - '0';
-	}
+/**
+ * @brief Flag the tiles that changed, along with their neighbors, as the
+ *        tiles to compute in the next generation.
+ * @param[in,out] grid The Game of Life grid.
+ */
+static void activate_tiles(grid_t* const grid);
 
-	// error if number of rows less than specified height
-	if (row < *height)
-		result = ASCIIGOL_BAD_DIMENSION;
+/**
+ * @brief Compute the next iteration of one band of the Game of Life grid.
+ * @param[in,out] context The Game of Life grid.
+ * @param[in] band The index of the band to compute.
+ * @param[in] num_bands The number of bands the grid is split into.
+ */
+static void compute_band(void* context, const uint32_t band, const uint32_t num_bands);
 
-	/***********
-	 * cleanup *
-	 ***********/
+/**
+ * @brief Compute the next iteration of the Game of Life grid.
+ * @param[in,out] grid The Game of Life grid.
+ * @return The result of computing the next Game of Life iteration.
+ */
+static asciigol_result_t compute_grid(grid_t* const grid);
 
-EXIT:
-	if (line) {
-		free(line);
-		line = NULL;
+/**
+ * @brief Compute the Game of Life universe some generations later.
+ *
+ * Only a single generation is recorded in the history and checked for
+ * convergence or a cycle, whereas a jump of more generations leaves the
+ * history to the caller.
+ *
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] generations The number of generations to advance by.
+ * @return The result of computing the Game of Life universe, never
+ *         `ASCIIGOL_CONVERGED` or `ASCIIGOL_CYCLED` for a jump.
+ */
+static asciigol_result_t compute_universe(grid_t* const grid, const uint64_t generations);
+
+/**
+ * @brief Compute the next iteration of the Game of Life plane.
+ * @param[in,out] grid The Game of Life grid.
+ * @return The result of computing the Game of Life plane.
+ */
+static asciigol_result_t compute_plane(grid_t* const grid);
+
+/**
+ * @brief Skip a number of generations without rendering them.
+ * @param[in,out] grid The Game of Life grid.
+ * @param[in] generations The number of generations to skip.
+ * @return The result of computing the last generation skipped.
+ */
+static asciigol_result_t jump_grid(grid_t* const grid, const uint64_t generations);
+
+/**
+ * @brief Retrieve a row of the Game of Life grid as one cell per byte.
+ * @param[in] grid The Game of Life grid.
+ * @param[in] row The row to retrieve.
+ * @return The cells of the row.
+ */
+static const cell_t* get_grid_row(grid_t* const grid, const uint32_t row);
+
+/**
+ * @brief Move the viewport of the Game of Life plane such that it follows the
+ *        live cells.
+ *
+ * The viewport only moves once the live cells leave it, by as little as keeps
+ * them in view, and is centered on them if they no longer fit.
+ *
+ * @param[in,out] grid The Game of Life grid.
+ */
+static void follow_plane(grid_t* const grid);
+
+/**
+ * @brief Capture the viewport of the Game of Life grid as one cell per byte.
+ * @param[in,out] grid The Game of Life grid.
+ * @param[out] frame The captured cells, row by row.
+ */
+static void capture_frame(grid_t* const grid, cell_t* const frame);
+
+/**
+ * @brief Map each state of a cell to the character rendering it.
+ *
+ * The dying states of a Generations rule spread over `DECAY_CHARS`, fading
+ * out as they approach death.
+ *
+ * @param[out] state_chars The characters, indexed by state.
+ * @param[in] live_char The character of a live cell, zero for the default.
+ * @param[in] dead_char The character of a dead cell, zero for the default.
+ * @param[in] num_states The number of states of the rule.
+ */
+static void init_state_chars(
+	char* const state_chars,
+	const char live_char,
+	const char dead_char,
+	const uint16_t num_states
+);
+
+/**
+ * @brief Render the Game of Life cells.
+ * @param[in,out] screen The screen to render to.
+ * @param[in] frame The cells captured from the Game of Life grid.
+ * @param[in] state_chars The character to render for each state of a cell.
+ * @param[in] background The background color type.
+ */
+static void render_cells(
+	screen_t* const screen,
+	const cell_t* const frame,
+	const char* const state_chars,
+	const asciigol_bg_t background
+);
+
+/**
+ * @brief Render the frames captured from the Game of Life grid until it stops
+ *        capturing them.
+ *
+ * Frames are scheduled against absolute deadlines, so the time spent
+ * rendering does not add to the delay. A frame following one that missed its
+ * deadline is skipped to catch up, but never two in a row so that rendering
+ * cannot starve.
+ *
+ * @param[in,out] context The renderer.
+ * @return Nothing.
+ */
+static void* render_frames(void* context);
+
+/**
+ * @brief Count the live cells of the Game of Life grid, leaving out the dying
+ *        cells of a Generations rule.
+ * @param[in] grid The Game of Life grid.
+ * @return The number of live cells.
+ */
+static uint64_t count_population(const grid_t* const grid);
+
+/**
+ * @brief Deallocate the Game of Life grid.
+ * @param[in,out] grid The Game of Life grid.
+ */
+static void destroy_grid(grid_t* const grid);
+
+asciigol_result_t asciigol(asciigol_args_t args, asciigol_summary_t* const summary) {
+	stats_t stats;
+	stats_init(&stats, args.stats);
+	uint64_t start = stats_start(&stats);
+	grid_t grid = { 0 };
+	asciigol_result_t result = init_grid(&grid, &args);
+	if (result != ASCIIGOL_OK)
+		return result;
+	stats_record(&stats, STATS_INIT, start);
+	if (args.jump)
+		result = jump_grid(&grid, args.jump);
+
+	// generations are computed ahead while the render thread draws earlier
+	// ones, so neither waits on the other unless the ring of frames is full
+	renderer_t renderer = { 0 };
+	renderer.grid = &grid;
+	renderer.stats = &stats;
+	renderer.delay = args.delay;
+	init_state_chars(renderer.state_chars, args.live_char, args.dead_char, grid.rule.num_states);
+	renderer.background = args.background;
+	if (!args.headless) {
+		clear_screen();
+		if (pthread_create(&renderer.thread, NULL, render_frames, &renderer)) {
+			destroy_grid(&grid);
+			return ASCIIGOL_BAD_THREADS;
+		}
+	}
+	while (result == ASCIIGOL_OK && (!args.generations || grid.generation < args.generations)) {
+		if (!args.headless) {
+			cell_t* const frame = ring_begin_push(&grid.frames);
+			start = stats_start(&stats);
+			capture_frame(&grid, frame);
+			stats_record(&stats, STATS_CAPTURE, start);
+			ring_end_push(&grid.frames);
+		}
+		start = stats_start(&stats);
+		result = compute_grid(&grid);
+		stats_record(&stats, STATS_COMPUTE, start);
 	}
+	if (!args.headless) {
+		ring_close(&grid.frames);
+		pthread_join(renderer.thread, NULL);
+	}
+	if (summary) {
+		summary->generations = grid.generation;
+		summary->population = count_population(&grid);
+		summary->period = grid.period;
+		summary->cycle_start = grid.cycle_start;
+		summary->missed_deadlines = renderer.missed_deadlines;
+		summary->seed = grid.seed;
+	}
+	if (args.stats)
+		stats_print(&stats, stderr);
+	destroy_grid(&grid);
+	return result;
+}
+
+const char* asciigol_result_name(const asciigol_result_t result) {
+	switch (result) {
+		case ASCIIGOL_OK:
+			return "ASCIIGOL_OK";
+		case ASCIIGOL_CONVERGED:
+			return "ASCIIGOL_CONVERGED";
+		case ASCIIGOL_BAD_FILE:
+			return "ASCIIGOL_BAD_FILE";
+		case ASCIIGOL_BAD_HEADER:
+			return "ASCIIGOL_BAD_HEADER";
+		case ASCIIGOL_BAD_DIMENSION:
+			return "ASCIIGOL_BAD_DIMENSION";
+		case ASCIIGOL_BAD_CELL:
+			return "ASCIIGOL_BAD_CELL";
+		case ASCIIGOL_CYCLED:
+			return "ASCIIGOL_CYCLED";
+		case ASCIIGOL_BAD_THREADS:
+			return "ASCIIGOL_BAD_THREADS";
+		case ASCIIGOL_BAD_RULE:
+			return "ASCIIGOL_BAD_RULE";
+		default:
+			return NULL;
+	}
+}
+
+asciigol_result_t asciigol_engine_create(asciigol_engine_t** const engine, asciigol_args_t args) {
+	*engine = (asciigol_engine_t*)calloc(1, sizeof(asciigol_engine_t));
+	if (!*engine)
+		return ASCIIGOL_BAD_DIMENSION;
+	const asciigol_result_t result = create_grid(&(*engine)->grid, args);
+	if (result != ASCIIGOL_OK) {
+		free(*engine);
+		*engine = NULL;
+		return result;
+	}
+	(*engine)->args = args;
+	(*engine)->args.filename = NULL;
+	(*engine)->args.seed = 0;
+	return result;
+}
+
+asciigol_result_t asciigol_engine_load(asciigol_engine_t* const engine, const char* const filename) {
+	asciigol_args_t args = engine->args;
+	args.filename = (char*)filename;
+	grid_t* grid;
+	const asciigol_result_t result = create_grid(&grid, args);
 	if (result != ASCIIGOL_OK)
+		return result;
+	destroy_grid(engine->grid);
+	free(engine->grid);
+	engine->grid = grid;
+	return result;
+}
+
+asciigol_result_t asciigol_engine_reseed(asciigol_engine_t* const engine, const uint64_t seed) {
+	// only a random byte grid or bitboard has buffers that can be refilled
+	grid_t* const grid = engine->grid;
+	const bool is_bounded = grid->backend == ASCIIGOL_BACKEND_BYTE || grid->backend == ASCIIGOL_BACKEND_BITBOARD;
+	if (is_bounded && grid->seed) {
+		reseed_grid(grid, seed ? seed : pick_seed(), engine->args.density);
+		return ASCIIGOL_OK;
+	}
+	asciigol_args_t args = engine->args;
+	args.seed = seed;
+	grid_t* new_grid;
+	const asciigol_result_t result = create_grid(&new_grid, args);
+	if (result != ASCIIGOL_OK)
+		return result;
+	destroy_grid(engine->grid);
+	free(engine->grid);
+	engine->grid = new_grid;
+	return result;
+}
+
+asciigol_result_t asciigol_engine_step(asciigol_engine_t* const engine, const uint64_t generations) {
+	return generations ? jump_grid(engine->grid, generations) : ASCIIGOL_OK;
+}
+
+void asciigol_engine_get_size(
+	const asciigol_engine_t* const engine,
+	uint32_t* const width,
+	uint32_t* const height
+) {
+	*width = engine->grid->width;
+	*height = engine->grid->height;
+}
+
+void asciigol_engine_get_cells(asciigol_engine_t* const engine, uint8_t* const cells) {
+	capture_frame(engine->grid, cells);
+}
+
+uint64_t asciigol_engine_population(const asciigol_engine_t* const engine) {
+	return count_population(engine->grid);
+}
+
+size_t asciigol_engine_get_live_cells(
+	asciigol_engine_t* const engine,
+	int64_t* const xs,
+	int64_t* const ys,
+	const size_t capacity
+) {
+	grid_t* const grid = engine->grid;
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE)
+		return plane_list_cells(&grid->plane, xs, ys, capacity);
+
+	// count the cells first, so that nothing is written without room for all
+	size_t num_cells = 0;
+	for (uint32_t row = 0; row < grid->height; row++) {
+		const cell_t* const cells = get_grid_row(grid, row);
+		for (uint32_t col = 0; col < grid->width; col++)
+			num_cells += cells[col] == 1;
+	}
+	if (num_cells > capacity)
+		return num_cells;
+	size_t i = 0;
+	for (uint32_t row = 0; row < grid->height; row++) {
+		const cell_t* const cells = get_grid_row(grid, row);
+		for (uint32_t col = 0; col < grid->width; col++)
+			if (cells[col] == 1) {
+				xs[i] = col;
+				ys[i] = row;
+				i++;
+			}
+	}
+	return num_cells;
+}
+
+size_t asciigol_engine_render_into(asciigol_engine_t* const engine, char* const buffer, const size_t size) {
+	grid_t* const grid = engine->grid;
+	const size_t line_size = (size_t)grid->width + 1;
+	const size_t needed = line_size * grid->height + 1;
+	if (!buffer || size < needed)
+		return needed;
+	char state_chars[RULE_MAX_STATES];
+	init_state_chars(state_chars, engine->args.live_char, engine->args.dead_char, grid->rule.num_states);
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE)
+		follow_plane(grid);
+	for (uint32_t row = 0; row < grid->height; row++) {
+		const cell_t* const cells = get_grid_row(grid, row);
+		char* const line = buffer + line_size * row;
+		for (uint32_t col = 0; col < grid->width; col++)
+			line[col] = state_chars[cells[col]];
+		line[grid->width] = '\n';
+	}
+	buffer[needed - 1] = '\0';
+	return needed;
+}
+
+void asciigol_engine_summarize(const asciigol_engine_t* const engine, asciigol_summary_t* const summary) {
+	const grid_t* const grid = engine->grid;
+	summary->generations = grid->generation;
+	summary->population = count_population(grid);
+	summary->period = grid->period;
+	summary->cycle_start = grid->cycle_start;
+	summary->missed_deadlines = 0;
+	summary->seed = grid->seed;
+}
+
+void asciigol_engine_destroy(asciigol_engine_t* const engine) {
+	if (!engine)
+		return;
+	destroy_grid(engine->grid);
+	free(engine->grid);
+	free(engine);
+}
+
+static void clear_screen() {
+	printf("\x1b[2J");
+	fflush(stdout);
+}
+
+static asciigol_result_t create_grid(grid_t** const grid, asciigol_args_t args) {
+	*grid = (grid_t*)calloc(1, sizeof(grid_t));
+	if (!*grid)
+		return ASCIIGOL_BAD_DIMENSION;
+	args.headless = true;
+	const asciigol_result_t result = init_grid(*grid, &args);
+	if (result != ASCIIGOL_OK) {
+		free(*grid);
+		*grid = NULL;
+	}
+	return result;
+}
+
+static void advance_deadline(struct timespec* const deadline, const uint16_t delay) {
+	const uint16_t millis = delay ? delay : DEFAULT_DELAY_MILLIS;
+	deadline->tv_sec += millis / MILLIS_PER_SECOND;
+	deadline->tv_nsec += (long)(millis % MILLIS_PER_SECOND) * NANOS_PER_MILLI;
+	if (deadline->tv_nsec >= (long)MILLIS_PER_SECOND * NANOS_PER_MILLI) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= (long)MILLIS_PER_SECOND * NANOS_PER_MILLI;
+	}
+}
+
+static bool wait(const struct timespec* const deadline) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec))
+		return false;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) == EINTR);
+	return true;
+}
+
+static void free_buffer(cell_t** buffer) {
+	if (*buffer) {
+		free(*buffer);
+		*buffer = NULL;
+	}
+}
+
+static bool compute_padded_size(const uint32_t width, const uint32_t height, size_t* const size) {
+	const size_t padded_width = (size_t)width + HALO_CELLS;
+	const size_t padded_height = (size_t)height + HALO_CELLS;
+	if (!width || !height || padded_width > SIZE_MAX / padded_height)
+		return false;
+	*size = padded_width * padded_height;
+	return true;
+}
+
+static size_t cell_index(const uint32_t width, const int64_t row, const int64_t col) {
+	return ((size_t)width + HALO_CELLS) * (size_t)(row + 1) + (size_t)(col + 1);
+}
+
+static asciigol_result_t init_cells_from_file(
+	cell_t** cells,
+	bitboard_t* const board,
+	uint32_t* const width,
+	uint32_t* const height,
+	rule_t* const rule,
+	char* const filename
+) {
+	int64_t temp_width, temp_height;
+	size_t size;
+	char* data = NULL;
+	size_t data_size = 0;
+	bool is_mapped = false;
+	char* line = NULL;
+	asciigol_result_t result = ASCIIGOL_OK;
+	FILE* file = fopen(filename, "r");
+
+	/****************************************
+	 * read constant first line: "asciigol" *
+	 ****************************************/
+
+	if (!file) {
+		result = ASCIIGOL_BAD_FILE;
+		goto EXIT;
+	}
+	if (rle_detect(filename, file)) {
+		result = init_cells_from_rle(cells, width, height, rule, file);
+		goto EXIT;
+	}
+	if (!load_file(file, &data, &data_size, &is_mapped)) {
+		result = ASCIIGOL_BAD_FILE;
+		goto EXIT;
+	}
+	const char* cursor = data;
+	const char* const end = data + data_size;
+	const size_t header_len = sizeof(CONFIG_HEADER) - 1;
+	if (data_size < header_len || memcmp(data, CONFIG_HEADER, header_len)) {
+		result = ASCIIGOL_BAD_HEADER;
+		goto EXIT;
+	}
+	cursor += header_len;
+
+	/*************************
+	 * read width and height *
+	 *************************/
+
+	if (cursor == end) {
+		result = ASCIIGOL_BAD_DIMENSION;
+		goto EXIT;
+	}
+	const char* const newline = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+	const char* const line_end = newline ? newline + 1 : end;
+	line = strndup(cursor, (size_t)(line_end - cursor));
+	if (!line || sscanf(line, "%ld,%ld", &temp_width, &temp_height) < 2) {
+		result = ASCIIGOL_BAD_DIMENSION;
+		goto EXIT;
+	}
+	if (temp_width <= 0 || temp_width > UINT32_MAX || temp_height <= 0 || temp_height > UINT32_MAX) {
+		result = ASCIIGOL_BAD_DIMENSION;
+		goto EXIT;
+	}
+
+	// the dimensions may be followed by the rule: "<width>,<height>,<rule>"
+	char* const rule_string = strchr(strchr(line, ',') + 1, ',');
+	if (rule_string) {
+		rule_string[strcspn(rule_string, "\r\n")] = '\0';
+		if (!rule_parse(rule_string + 1, rule)) {
+			result = ASCIIGOL_BAD_RULE;
+			goto EXIT;
+		}
+	}
+	*width = (uint32_t)temp_width;
+	*height = (uint32_t)temp_height;
+	cursor = line_end;
+
+	/****************************
+	 * read initial cell states *
+	 ****************************/
+
+	if (board) {
+		if (!bitboard_init(board, *width, *height)) {
+			result = ASCIIGOL_BAD_DIMENSION;
+			goto EXIT;
+		}
+	} else {
+		if (!compute_padded_size(*width, *height, &size)) {
+			result = ASCIIGOL_BAD_DIMENSION;
+			goto EXIT;
+		}
+		*cells = (cell_t*)calloc(size, sizeof(cell_t));
+		if (!*cells) {
+			result = ASCIIGOL_BAD_DIMENSION;
+			goto EXIT;
+		}
+	}
+	for (uint32_t row = 0; row < *height; row++) {
+		cell_t* const row_cells = board ? NULL : *cells + cell_index(*width, row, 0);
+		uint64_t* const words = board ? board->words + board->words_per_row * row : NULL;
+		result = parse_row(&cursor, end, *width, row_cells, words);
+		if (result != ASCIIGOL_OK)
+			goto EXIT;
+	}
+
+	// error if number of rows greater than specified height
+	if (cursor < end)
+		result = ASCIIGOL_BAD_DIMENSION;
+
+	/***********
+	 * cleanup *
+	 ***********/
+
+EXIT:
+	if (line) {
+		free(line);
+		line = NULL;
+	}
+	unload_file(data, data_size, is_mapped);
+	if (result != ASCIIGOL_OK) {
 		free_buffer(cells);
+		if (board)
+			bitboard_destroy(board);
+	}
 	if (file) {
 		fclose(file);
 		file = NULL;
@@ -412,191 +1274,823 @@ EXIT:
 	return result;
 }
 
-static asciigol_result_t init_cells_at_random(
+static bool load_file(FILE* const file, char** const data, size_t* const size, bool* const is_mapped) {
+	*data = NULL;
+	*size = 0;
+	*is_mapped = false;
+	struct stat status;
+	if (!fstat(fileno(file), &status) && S_ISREG(status.st_mode)) {
+		if (!status.st_size)
+			return true;
+		void* const mapping = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+		if (mapping != MAP_FAILED) {
+			madvise(mapping, (size_t)status.st_size, MADV_SEQUENTIAL);
+			*data = (char*)mapping;
+			*size = (size_t)status.st_size;
+			*is_mapped = true;
+			return true;
+		}
+	}
+
+	// files that cannot be mapped, such as pipes, are read in blocks
+	size_t capacity = 0;
+	size_t num_read;
+	do {
+		if (*size == capacity) {
+			capacity += READ_BLOCK_SIZE;
+			char* const grown = (char*)realloc(*data, capacity);
+			if (!grown) {
+				free(*data);
+				*data = NULL;
+				return false;
+			}
+			*data = grown;
+		}
+		num_read = fread(*data + *size, 1, capacity - *size, file);
+		*size += num_read;
+	} while (num_read);
+	return !ferror(file);
+}
+
+static void unload_file(char* const data, const size_t size, const bool is_mapped) {
+	if (is_mapped)
+		munmap(data, size);
+	else
+		free(data);
+}
+
+static asciigol_result_t parse_row(
+	const char** const cursor,
+	const char* const end,
+	const uint32_t width,
+	cell_t* const cells,
+	uint64_t* const words
+) {
+	const char* const chars = *cursor;
+	const size_t remaining = (size_t)(end - chars);
+	const size_t limit = remaining < (size_t)width + 1 ? remaining : (size_t)width + 1;
+	const char* const newline = (const char*)memchr(chars, '\n', limit);
+	const size_t length = newline ? (size_t)(newline - chars) : limit;
+
+	// characters within the width are checked before the length of the row
+	const uint32_t num_cells = length < width ? (uint32_t)length : width;
+	const bool is_valid = cells ? convert_chars(chars, num_cells, cells) : pack_chars(chars, num_cells, words);
+	if (!is_valid)
+		return ASCIIGOL_BAD_CELL;
+	if (length < width)
+		return ASCIIGOL_BAD_DIMENSION;
+	if (!newline) {
+		// the row either outgrows the width or ends the file without a newline
+		const bool is_extra_cell = length > width && (chars[width] == '0' || chars[width] == '1');
+		return length > width && !is_extra_cell ? ASCIIGOL_BAD_CELL : ASCIIGOL_BAD_DIMENSION;
+	}
+	*cursor = newline + 1;
+	return ASCIIGOL_OK;
+}
+
+static bool convert_chars(const char* const chars, const uint32_t width, cell_t* const cells) {
+	uint64_t invalid = 0;
+	uint32_t col = 0;
+	for (; col + sizeof(uint64_t) <= width; col += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, chars + col, sizeof(uint64_t));
+		word ^= ZERO_CHARS;
+		invalid |= word & NON_CELL_BITS;
+		memcpy(cells + col, &word, sizeof(uint64_t));
+	}
+	for (; col < width; col++) {
+		const cell_t cell = (cell_t)(chars[col] ^ '0');
+		invalid |= cell & ~1;
+		cells[col] = cell;
+	}
+	return !invalid;
+}
+
+static bool pack_chars(const char* const chars, const uint32_t width, uint64_t* const words) {
+	uint64_t invalid = 0;
+	uint32_t col = 0;
+	for (; col + sizeof(uint64_t) <= width; col += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, chars + col, sizeof(uint64_t));
+		word ^= ZERO_CHARS;
+		invalid |= word & NON_CELL_BITS;
+		const uint64_t bits = ((word & ~NON_CELL_BITS) * GATHER_BITS) >> 56;
+		words[col / BITBOARD_WORD_BITS] |= bits << (col % BITBOARD_WORD_BITS);
+	}
+	for (; col < width; col++) {
+		const uint8_t cell = (uint8_t)(chars[col] ^ '0');
+		invalid |= cell & ~1;
+		words[col / BITBOARD_WORD_BITS] |= (uint64_t)(cell & 1) << (col % BITBOARD_WORD_BITS);
+	}
+	return !invalid;
+}
+
+static asciigol_result_t init_cells_from_rle(
 	cell_t** cells,
-	uint8_t* const width,
-	uint8_t* const height
+	uint32_t* const width,
+	uint32_t* const height,
+	rule_t* const rule,
+	FILE* const file
 ) {
-	if (*width > UINT8_MAX || *height > UINT8_MAX)
+	rle_header_t header;
+	switch (rle_read_header(file, &header)) {
+		case RLE_OK:
+			break;
+		case RLE_BAD_DIMENSION:
+			return ASCIIGOL_BAD_DIMENSION;
+		default:
+			return ASCIIGOL_BAD_HEADER;
+	}
+	if (header.rule[0] && !rule_parse(header.rule, rule))
+		return ASCIIGOL_BAD_RULE;
+	size_t size;
+	if (!compute_padded_size(header.width, header.height, &size))
 		return ASCIIGOL_BAD_DIMENSION;
-	*width = *width ? *width : DEFAULT_WIDTH;
-	*height = *height ? *height : DEFAULT_HEIGHT;
-	uint16_t size = *width * *height;
-	*cells = (cell_t*)malloc(size);
+	*cells = (cell_t*)calloc(size, sizeof(cell_t));
 	if (!*cells)
 		return ASCIIGOL_BAD_DIMENSION;
-	srand(time(NULL));
-	for (uint16_t i = 0; i < size; i++)
-		(*cells)[i] = (cell_t)(rand() % 2);
+	*width = header.width;
+	*height = header.height;
+	switch (rle_read_cells(file, &header, *cells + cell_index(*width, 0, 0), (size_t)*width + HALO_CELLS)) {
+		case RLE_OK:
+			return ASCIIGOL_OK;
+		case RLE_BAD_CELL:
+			return ASCIIGOL_BAD_CELL;
+		default:
+			return ASCIIGOL_BAD_DIMENSION;
+	}
+}
+
+static asciigol_result_t init_cells_at_random(
+	cell_t** cells,
+	bitboard_t* const board,
+	threadpool_t* const pool,
+	uint32_t* const width,
+	uint32_t* const height,
+	const uint64_t seed,
+	const uint8_t density
+) {
+	*width = *width ? *width : DEFAULT_WIDTH;
+	*height = *height ? *height : DEFAULT_HEIGHT;
+	if (board) {
+		if (!bitboard_init(board, *width, *height))
+			return ASCIIGOL_BAD_DIMENSION;
+	} else {
+		size_t size;
+		if (!compute_padded_size(*width, *height, &size))
+			return ASCIIGOL_BAD_DIMENSION;
+		*cells = (cell_t*)calloc(size, sizeof(cell_t));
+		if (!*cells)
+			return ASCIIGOL_BAD_DIMENSION;
+	}
+	fill_soup(*cells, board, pool, *width, *height, seed, density);
 	return ASCIIGOL_OK;
 }
 
+static void fill_soup(
+	cell_t* const cells,
+	bitboard_t* const board,
+	threadpool_t* const pool,
+	const uint32_t width,
+	const uint32_t height,
+	const uint64_t seed,
+	const uint8_t density
+) {
+	const uint32_t percent = density ? density : DEFAULT_DENSITY_PERCENT;
+	soup_t soup = { cells, board, width, height, seed, 0 };
+	soup.probability = (percent * ((uint32_t)1 << PRNG_PROBABILITY_BITS) + 50) / 100;
+	threadpool_run(pool, fill_soup_band, &soup);
+}
+
+static void fill_soup_band(void* context, const uint32_t band, const uint32_t num_bands) {
+	const soup_t* const soup = (const soup_t*)context;
+	const uint32_t row_begin = (uint32_t)((uint64_t)soup->height * band / num_bands);
+	const uint32_t row_end = (uint32_t)((uint64_t)soup->height * (band + 1) / num_bands);
+	const size_t words_per_row = ((size_t)soup->width + BITBOARD_WORD_BITS - 1) / BITBOARD_WORD_BITS;
+	const uint32_t tail_bits = soup->width % BITBOARD_WORD_BITS;
+	for (uint32_t row = row_begin; row < row_end; row++) {
+		prng_t prng;
+		prng_seed(&prng, soup->seed, row);
+		uint64_t* const words = soup->board ? soup->board->words + soup->board->words_per_row * row : NULL;
+		cell_t* const cells = soup->board ? NULL : soup->cells + cell_index(soup->width, row, 0);
+		for (size_t w = 0; w < words_per_row; w++) {
+			const uint64_t bits = prng_next_bits(&prng, soup->probability);
+			const bool is_tail = tail_bits && w == words_per_row - 1;
+			if (words) {
+				words[w] = is_tail ? bits & (((uint64_t)1 << tail_bits) - 1) : bits;
+				continue;
+			}
+			cell_t* const word_cells = cells + w * BITBOARD_WORD_BITS;
+			const uint32_t num_cells = is_tail ? tail_bits : BITBOARD_WORD_BITS;
+			for (uint32_t c = 0; c < num_cells; c++)
+				word_cells[c] = (cell_t)((bits >> c) & 1);
+		}
+	}
+}
+
+static uint64_t pick_seed() {
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	const uint64_t seed = (uint64_t)now.tv_sec * MILLIS_PER_SECOND * NANOS_PER_MILLI + (uint64_t)now.tv_nsec;
+	return seed ? seed : 1;
+}
+
 static asciigol_result_t init_back_buffer(
 	cell_t** back_buffer,
-	const uint16_t size
+	const size_t size
 ) {
-	*back_buffer = (cell_t*)malloc(size);
+	*back_buffer = (cell_t*)calloc(size, sizeof(cell_t));
 	if (!*back_buffer)
 		return ASCIIGOL_BAD_DIMENSION;
 	return ASCIIGOL_OK;
 }
 
-static asciigol_result_t init_cells(
-	cell_t** cells,
-	cell_t** back_buffer,
-	uint8_t* const width,
-	uint8_t* const height,
-	char* const filename
-) {
+static asciigol_result_t init_cells(grid_t* const grid, asciigol_args_t* const args) {
 	asciigol_result_t result = ASCIIGOL_OK;
-	if (filename)
-		result = init_cells_from_file(cells, width, height, filename);
-	else
-		result = init_cells_at_random(cells, width, height);
-	if (result != ASCIIGOL_OK)
+	bitboard_t* const board = grid->backend == ASCIIGOL_BACKEND_BITBOARD ? &grid->board : NULL;
+	if (args->filename)
+		result = init_cells_from_file(&grid->cells, board, &args->width, &args->height, &grid->rule, args->filename);
+	else {
+		grid->seed = args->seed ? args->seed : pick_seed();
+		result = init_cells_at_random(&grid->cells, board, &grid->pool, &args->width, &args->height, grid->seed, args->density);
+	}
+
+	// cells packed into the bitboard need no byte buffers
+	if (result != ASCIIGOL_OK || !grid->cells)
 		return result;
-	result = init_back_buffer(back_buffer, *width * *height);
+	size_t size = 0;
+	compute_padded_size(args->width, args->height, &size);
+	result = init_back_buffer(&grid->back_buffer, size);
 	if (result != ASCIIGOL_OK)
-		free_buffer(cells);
+		free_buffer(&grid->cells);
 	return result;
 }
 
-static uint8_t count_live_neighbors(
-	cell_t* cells,
-	const uint8_t row,
-	const uint8_t col,
-	const uint8_t width,
-	const uint8_t height,
+static void fill_halo(
+	cell_t* const cells,
+	const uint32_t width,
+	const uint32_t height,
 	const bool wrap
 ) {
-	// get neighbor range; will go out of grid range when wrap is enabled
-	int16_t row_begin = row || wrap ? row - 1 : row;
-	int16_t col_begin = col || wrap ? col - 1 : col;
-	int16_t row_end = row < height - 1 || wrap ? row + 1 : row;
-	int16_t col_end = col < width - 1 || wrap ? col + 1 : col;
-	uint8_t num_live_neighbors = 0;
-	for (int16_t r = row_begin; r <= row_end; r++) {
-
-		// account for wrap around
-		uint8_t neighbor_row;
-		if (r == -1)
-			neighbor_row = height - 1;
-		else if (r == height)
-			neighbor_row = 0;
-		else
-			neighbor_row = (uint8_t)r;
-
-		for (int16_t c = col_begin; c <= col_end; c++) {
-
-			// account for wrap around
-			uint8_t neighbor_col;
-			if (c == -1)
-				neighbor_col = width - 1;
-			else if (c == width)
-				neighbor_col = 0;
-			else
-				neighbor_col = (uint8_t)c;
-
-			// count neighbor if live
-			cell_t neighbor = cells[width * neighbor_row + neighbor_col];
-			if (neighbor && (neighbor_row != row || neighbor_col != col))
-				num_live_neighbors++;
+	// a bounded halo only ever holds dead cells, which are zeroed on allocation
+	// and never written to by compute_tile
+	if (!wrap)
+		return;
+
+	// left and right ghost columns mirror the opposite edges
+	for (uint32_t row = 0; row < height; row++) {
+		cell_t* const row_cells = cells + cell_index(width, row, 0);
+		row_cells[-1] = row_cells[width - 1];
+		row_cells[width] = row_cells[0];
+	}
+
+	// top and bottom ghost rows, including corners, mirror the opposite edges
+	const size_t padded_width = (size_t)width + HALO_CELLS;
+	memcpy(cells + cell_index(width, -1, -1), cells + cell_index(width, height - 1, -1), padded_width);
+	memcpy(cells + cell_index(width, height, -1), cells + cell_index(width, 0, -1), padded_width);
+}
+
+static void swap_buffers(cell_t** buffer_a, cell_t** buffer_b) {
+	cell_t* temp = *buffer_a;
+	*buffer_a = *buffer_b;
+	*buffer_b = temp;
+}
+
+static void destroy_cells(cell_t** cells, cell_t** back_buffer) {
+	free_buffer(cells);
+	free_buffer(back_buffer);
+}
+
+static asciigol_result_t init_grid(grid_t* const grid, asciigol_args_t* const args) {
+	grid->backend = args->backend;
+	grid->wrap = args->wrap;
+
+	// the pool is spawned first as it also fills a random initial state
+	asciigol_result_t result = init_pool(grid, args->threads);
+	if (result == ASCIIGOL_OK && !rule_parse(args->rule ? args->rule : RULE_CONWAY, &grid->rule))
+		result = ASCIIGOL_BAD_RULE;
+	if (result == ASCIIGOL_OK)
+		result = init_cells(grid, args);
+
+	// the rule of a file is only known once it is read, and only bytes hold
+	// the states of a Generations rule
+	if (result == ASCIIGOL_OK && grid->rule.num_states > 2 && grid->backend != ASCIIGOL_BACKEND_BYTE)
+		result = ASCIIGOL_BAD_RULE;
+	if (result != ASCIIGOL_OK) {
+		destroy_grid(grid);
+		return result;
+	}
+	grid->width = args->width;
+	grid->height = args->height;
+	kernel_select(&grid->kernel, grid->rule);
+	if (grid->backend == ASCIIGOL_BACKEND_BITBOARD)
+		result = init_bitboards(grid);
+	else if (grid->backend == ASCIIGOL_BACKEND_HASHLIFE)
+		result = init_universe(grid);
+	else if (grid->backend == ASCIIGOL_BACKEND_PLANE)
+		result = init_plane(grid);
+	else
+		result = init_tiles(grid);
+	if (result == ASCIIGOL_OK)
+		result = init_history(grid, args->max_period);
+	if (result == ASCIIGOL_OK && !args->headless)
+		result = init_screen(grid);
+	if (result != ASCIIGOL_OK)
+		destroy_grid(grid);
+	return result;
+}
+
+static asciigol_result_t init_bitboards(grid_t* const grid) {
+	if (!bitboard_init(&grid->back_board, grid->width, grid->height))
+		return ASCIIGOL_BAD_DIMENSION;
+	if (grid->cells) {
+		if (!bitboard_init(&grid->board, grid->width, grid->height))
+			return ASCIIGOL_BAD_DIMENSION;
+		for (uint32_t row = 0; row < grid->height; row++)
+			bitboard_pack_row(&grid->board, row, grid->cells + cell_index(grid->width, row, 0));
+		destroy_cells(&grid->cells, &grid->back_buffer);
+	}
+	grid->row_buffer = (cell_t*)malloc(grid->width);
+	if (!grid->row_buffer)
+		return ASCIIGOL_BAD_DIMENSION;
+	return ASCIIGOL_OK;
+}
+
+static asciigol_result_t init_universe(grid_t* const grid) {
+	const size_t stride = (size_t)grid->width + HALO_CELLS;
+	if (!hashlife_init(&grid->universe, grid->cells + cell_index(grid->width, 0, 0), stride, grid->width, grid->height, grid->rule))
+		return ASCIIGOL_BAD_DIMENSION;
+	destroy_cells(&grid->cells, &grid->back_buffer);
+	grid->row_buffer = (cell_t*)malloc(grid->width);
+	if (!grid->row_buffer)
+		return ASCIIGOL_BAD_DIMENSION;
+	return ASCIIGOL_OK;
+}
+
+static asciigol_result_t init_plane(grid_t* const grid) {
+	const size_t stride = (size_t)grid->width + HALO_CELLS;
+	if (!plane_init(&grid->plane, grid->cells + cell_index(grid->width, 0, 0), stride, grid->width, grid->height, grid->rule))
+		return ASCIIGOL_BAD_DIMENSION;
+	destroy_cells(&grid->cells, &grid->back_buffer);
+	grid->row_buffer = (cell_t*)malloc(grid->width);
+	if (!grid->row_buffer)
+		return ASCIIGOL_BAD_DIMENSION;
+	return ASCIIGOL_OK;
+}
+
+static asciigol_result_t init_tiles(grid_t* const grid) {
+	grid->tile_cols = (uint32_t)(((uint64_t)grid->width + TILE_COLS - 1) / TILE_COLS);
+	grid->tile_rows = (uint32_t)(((uint64_t)grid->height + TILE_ROWS - 1) / TILE_ROWS);
+	const size_t num_tiles = (size_t)grid->tile_cols * grid->tile_rows;
+	grid->active_tiles = (bool*)malloc(num_tiles * sizeof(bool));
+	grid->changed_tiles = (bool*)calloc(num_tiles, sizeof(bool));
+	grid->tile_hashes = (uint64_t*)calloc(num_tiles, sizeof(uint64_t));
+	if (!grid->active_tiles || !grid->changed_tiles || !grid->tile_hashes)
+		return ASCIIGOL_BAD_DIMENSION;
+	for (size_t tile = 0; tile < num_tiles; tile++)
+		grid->active_tiles[tile] = true;
+	return ASCIIGOL_OK;
+}
+
+static asciigol_result_t init_pool(grid_t* const grid, const uint16_t threads) {
+	// a single band fills the soup of the unbounded backends on the caller alone
+	const bool uses_bands = grid->backend != ASCIIGOL_BACKEND_HASHLIFE && grid->backend != ASCIIGOL_BACKEND_PLANE;
+	const uint32_t num_threads = threads && uses_bands ? threads : 1;
+	grid->bands = (band_t*)malloc(num_threads * sizeof(band_t));
+	if (!grid->bands)
+		return ASCIIGOL_BAD_THREADS;
+	if (!threadpool_init(&grid->pool, num_threads)) {
+		free(grid->bands);
+		grid->bands = NULL;
+		return ASCIIGOL_BAD_THREADS;
+	}
+	return ASCIIGOL_OK;
+}
+
+static asciigol_result_t init_history(grid_t* const grid, const uint16_t max_period) {
+	if (!cycle_init(&grid->history, max_period ? max_period : DEFAULT_MAX_PERIOD))
+		return ASCIIGOL_BAD_DIMENSION;
+	record_initial_generation(grid);
+	return ASCIIGOL_OK;
+}
+
+static void record_initial_generation(grid_t* const grid) {
+	uint64_t start;
+	if (grid->backend == ASCIIGOL_BACKEND_HASHLIFE) {
+		cycle_record(&grid->history, hashlife_hash(&grid->universe), &start);
+		return;
+	}
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE) {
+		cycle_record(&grid->history, plane_hash(&grid->plane), &start);
+		return;
+	}
+	for (uint32_t band = 0; band < grid->pool.num_threads; band++) {
+		uint32_t row_begin, row_end;
+		get_band_rows(grid, band, grid->pool.num_threads, &row_begin, &row_end);
+		if (grid->backend == ASCIIGOL_BACKEND_BITBOARD) {
+			grid->bands[band].hash = hash_rows(grid, false, row_begin, row_end);
+			continue;
 		}
+		grid->bands[band].hash = 0;
+		for (uint32_t tile_row = row_begin / TILE_ROWS; (uint64_t)tile_row * TILE_ROWS < row_end; tile_row++)
+			for (uint32_t tile_col = 0; tile_col < grid->tile_cols; tile_col++) {
+				const size_t tile = (size_t)tile_row * grid->tile_cols + tile_col;
+				grid->tile_hashes[tile] = hash_tile(grid, grid->cells, tile_row, tile_col);
+				grid->bands[band].hash += grid->tile_hashes[tile];
+			}
 	}
-	return num_live_neighbors;
+	cycle_record(&grid->history, combine_band_hashes(grid), &start);
 }
 
-static cell_t compute_game_of_life(
-	const cell_t cell,
-	const uint8_t num_live_neighbors
+static void reseed_grid(grid_t* const grid, const uint64_t seed, const uint8_t density) {
+	const bool is_bitboard = grid->backend == ASCIIGOL_BACKEND_BITBOARD;
+	fill_soup(grid->cells, is_bitboard ? &grid->board : NULL, &grid->pool, grid->width, grid->height, seed, density);
+	if (!is_bitboard) {
+		const size_t num_tiles = (size_t)grid->tile_cols * grid->tile_rows;
+		memset(grid->active_tiles, true, num_tiles * sizeof(bool));
+		memset(grid->changed_tiles, false, num_tiles * sizeof(bool));
+	}
+	grid->seed = seed;
+	grid->generation = 0;
+	grid->period = 0;
+	grid->cycle_start = 0;
+	grid->history_offset = 0;
+	cycle_clear(&grid->history);
+	record_initial_generation(grid);
+}
+
+static asciigol_result_t init_screen(grid_t* const grid) {
+	if (!screen_init(&grid->screen, grid->width, grid->height, PALETTE, STDOUT_FILENO) ||
+	    !ring_init(&grid->frames, NUM_FRAMES, (size_t)grid->width * grid->height))
+		return ASCIIGOL_BAD_DIMENSION;
+	return ASCIIGOL_OK;
+}
+
+static void get_band_rows(
+	const grid_t* const grid,
+	const uint32_t band,
+	const uint32_t num_bands,
+	uint32_t* const row_begin,
+	uint32_t* const row_end
 ) {
-	// Game of Life rules
-	if (cell && num_live_neighbors < 2)
-		return 0;
-	if (cell && (num_live_neighbors == 2 || num_live_neighbors == 3))
-		return 1;
-	if (cell && num_live_neighbors > 3)
-		return 0;
-	if (!cell && num_live_neighbors == 3)
-		return 1;
-	return 0;
-}
-
-static cell_t compute_cell(
-	cell_t* const cells,
-	const uint8_t row,
-	const uint8_t col,
-	const uint8_t width,
-	const uint8_t height,
-	const bool wrap
+	// bands start at the start of a tile so that no tile is shared
+	const uint64_t tile_rows = ((uint64_t)grid->height + TILE_ROWS - 1) / TILE_ROWS;
+	const uint64_t tile_begin = tile_rows * band / num_bands;
+	const uint64_t tile_end = tile_rows * (band + 1) / num_bands;
+	*row_begin = (uint32_t)(tile_begin * TILE_ROWS < grid->height ? tile_begin * TILE_ROWS : grid->height);
+	*row_end = (uint32_t)(tile_end * TILE_ROWS < grid->height ? tile_end * TILE_ROWS : grid->height);
+}
+
+static uint64_t hash_rows(
+	const grid_t* const grid,
+	const bool back,
+	const uint32_t row_begin,
+	const uint32_t row_end
 ) {
-	cell_t cell = cells[width * row + col];
-	uint8_t num_live_neighbors = count_live_neighbors(cells, row, col, width, height, wrap);
-	return compute_game_of_life(cell, num_live_neighbors);
+	uint64_t hash = 0;
+	const bitboard_t* const board = back ? &grid->back_board : &grid->board;
+	const size_t row_size = board->words_per_row * sizeof(uint64_t);
+	for (uint32_t row = row_begin; row < row_end; row++)
+		hash = cycle_hash(hash, board->words + board->words_per_row * row, row_size);
+	return hash;
 }
 
-static asciigol_result_t compute_cells(
-	cell_t* cells,
-	cell_t* new_cells,
-	const uint8_t width,
-	const uint8_t height,
-	const bool wrap
+static uint64_t hash_tile(
+	const grid_t* const grid,
+	const cell_t* const cells,
+	const uint32_t tile_row,
+	const uint32_t tile_col
 ) {
+	const uint32_t row_begin = tile_row * TILE_ROWS;
+	const uint32_t row_end = grid->height - row_begin < TILE_ROWS ? grid->height : row_begin + TILE_ROWS;
+	const uint32_t col_begin = tile_col * TILE_COLS;
+	const uint32_t cols = grid->width - col_begin < TILE_COLS ? grid->width - col_begin : TILE_COLS;
+	uint64_t hash = (uint64_t)tile_row * grid->tile_cols + tile_col + 1;
+	for (uint32_t row = row_begin; row < row_end; row++)
+		hash = cycle_hash(hash, cells + cell_index(grid->width, row, col_begin), cols);
+	return hash;
+}
+
+static bool compute_tile(grid_t* const grid, const uint32_t tile_row, const uint32_t tile_col) {
+	const uint32_t width = grid->width;
+	const uint32_t row_begin = tile_row * TILE_ROWS;
+	const uint32_t row_end = grid->height - row_begin < TILE_ROWS ? grid->height : row_begin + TILE_ROWS;
+	const uint32_t col_begin = tile_col * TILE_COLS;
+	const uint32_t cols = width - col_begin < TILE_COLS ? width - col_begin : TILE_COLS;
+	bool changed = false;
+	for (uint32_t row = row_begin; row < row_end; row++) {
+		const size_t index = cell_index(width, row, col_begin);
+		const cell_t* const above = grid->cells + cell_index(width, (int64_t)row - 1, col_begin);
+		const cell_t* const below = grid->cells + cell_index(width, row + 1, col_begin);
+		if (grid->kernel.row(&grid->kernel, above, grid->cells + index, below, grid->back_buffer + index, cols))
+			changed = true;
+	}
+	return changed;
+}
+
+static asciigol_result_t compute_tiles(
+	grid_t* const grid,
+	const uint32_t band,
+	const uint32_t row_begin,
+	const uint32_t row_end
+) {
+	// an inactive tile stays as it was, which the back-buffer already holds
+	// since the tile did not change when it was last computed either
 	bool converged = true;
-	uint16_t size = width * height;
-	for (uint16_t i = 0; i < size; i++) {
-		uint8_t row = (uint8_t)(i / width);
-		uint8_t col = (uint8_t)(i % width);
-		cell_t cell = cells[i];
-		cell_t new_cell = compute_cell(cells, row, col, width, height, wrap);
-		if (cell != new_cell)
+	for (uint32_t tile_row = row_begin / TILE_ROWS; (uint64_t)tile_row * TILE_ROWS < row_end; tile_row++)
+		for (uint32_t tile_col = 0; tile_col < grid->tile_cols; tile_col++) {
+			const size_t tile = (size_t)tile_row * grid->tile_cols + tile_col;
+			const bool changed = grid->active_tiles[tile] && compute_tile(grid, tile_row, tile_col);
+			grid->changed_tiles[tile] = changed;
+			if (!changed)
+				continue;
 			converged = false;
-		new_cells[i] = new_cell;
-	}
+			const uint64_t hash = hash_tile(grid, grid->back_buffer, tile_row, tile_col);
+			grid->bands[band].hash += hash - grid->tile_hashes[tile];
+			grid->tile_hashes[tile] = hash;
+		}
 	return converged ? ASCIIGOL_CONVERGED : ASCIIGOL_OK;
 }
 
-static void swap_buffers(cell_t** buffer_a, cell_t** buffer_b) {
-	cell_t* temp = *buffer_a;
-	*buffer_a = *buffer_b;
-	*buffer_b = temp;
+static void activate_tiles(grid_t* const grid) {
+	const int64_t tile_cols = grid->tile_cols;
+	const int64_t tile_rows = grid->tile_rows;
+	for (int64_t tile_row = 0; tile_row < tile_rows; tile_row++)
+		for (int64_t tile_col = 0; tile_col < tile_cols; tile_col++) {
+			bool active = false;
+			for (int64_t row = tile_row - 1; row <= tile_row + 1 && !active; row++)
+				for (int64_t col = tile_col - 1; col <= tile_col + 1 && !active; col++) {
+					const bool is_outside = row < 0 || row >= tile_rows || col < 0 || col >= tile_cols;
+					if (is_outside && !grid->wrap)
+						continue;
+					const int64_t neighbor_row = (row + tile_rows) % tile_rows;
+					const int64_t neighbor_col = (col + tile_cols) % tile_cols;
+					active = grid->changed_tiles[neighbor_row * tile_cols + neighbor_col];
+				}
+			grid->active_tiles[tile_row * tile_cols + tile_col] = active;
+		}
 }
 
-static void render_cells(
-	cell_t* const cells,
-	const uint8_t width,
-	const uint8_t height,
+static uint64_t combine_band_hashes(const grid_t* const grid) {
+	uint64_t hash = 0;
+	for (uint32_t band = 0; band < grid->pool.num_threads; band++)
+		hash = cycle_hash(hash, &grid->bands[band].hash, sizeof(uint64_t));
+	return hash;
+}
+
+static void compute_band(void* context, const uint32_t band, const uint32_t num_bands) {
+	grid_t* const grid = (grid_t*)context;
+	uint32_t row_begin, row_end;
+	get_band_rows(grid, band, num_bands, &row_begin, &row_end);
+	if (grid->backend == ASCIIGOL_BACKEND_BITBOARD) {
+		const bool changed = bitboard_step_rows(&grid->board, &grid->back_board, grid->wrap, &grid->rule, row_begin, row_end);
+		grid->bands[band].result = changed ? ASCIIGOL_OK : ASCIIGOL_CONVERGED;
+	}
+	else {
+		grid->bands[band].result = compute_tiles(grid, band, row_begin, row_end);
+		return;
+	}
+
+	// hash the rows while they are still in cache
+	grid->bands[band].hash = hash_rows(grid, true, row_begin, row_end);
+}
+
+static asciigol_result_t record_generation(
+	grid_t* const grid,
+	const uint64_t hash,
+	asciigol_result_t result
+) {
+	// a generation repeating one of the last few means the grid oscillates
+	uint64_t start;
+	const uint32_t period = cycle_record(&grid->history, hash, &start);
+	if (result == ASCIIGOL_CONVERGED) {
+		grid->period = 1;
+		grid->cycle_start = grid->generation - 1;
+	}
+	else if (period) {
+		grid->period = period;
+		grid->cycle_start = grid->history_offset + start;
+		result = ASCIIGOL_CYCLED;
+	}
+	return result;
+}
+
+static asciigol_result_t compute_grid(grid_t* const grid) {
+	if (grid->backend == ASCIIGOL_BACKEND_HASHLIFE)
+		return compute_universe(grid, 1);
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE)
+		return compute_plane(grid);
+	if (grid->backend == ASCIIGOL_BACKEND_BYTE)
+		fill_halo(grid->cells, grid->width, grid->height, grid->wrap);
+
+	// every band has been computed once the pool returns from its barrier
+	threadpool_run(&grid->pool, compute_band, grid);
+	if (grid->backend == ASCIIGOL_BACKEND_BITBOARD) {
+		const bitboard_t temp = grid->board;
+		grid->board = grid->back_board;
+		grid->back_board = temp;
+	}
+	else {
+		swap_buffers(&grid->cells, &grid->back_buffer);
+		activate_tiles(grid);
+	}
+
+	grid->generation++;
+
+	asciigol_result_t result = ASCIIGOL_CONVERGED;
+	for (uint32_t band = 0; band < grid->pool.num_threads; band++)
+		if (grid->bands[band].result != ASCIIGOL_CONVERGED)
+			result = ASCIIGOL_OK;
+	return record_generation(grid, combine_band_hashes(grid), result);
+}
+
+static asciigol_result_t compute_universe(grid_t* const grid, const uint64_t generations) {
+	const uint64_t hash = hashlife_hash(&grid->universe);
+	if (!hashlife_step(&grid->universe, generations))
+		return ASCIIGOL_BAD_DIMENSION;
+	grid->generation += generations;
+
+	// a jump landing on the state it started from only means that the period
+	// divides it, and its generations are not in the history to tell which
+	if (generations > 1)
+		return ASCIIGOL_OK;
+	const uint64_t new_hash = hashlife_hash(&grid->universe);
+	return record_generation(grid, new_hash, new_hash == hash ? ASCIIGOL_CONVERGED : ASCIIGOL_OK);
+}
+
+static asciigol_result_t compute_plane(grid_t* const grid) {
+	bool changed;
+	if (!plane_step(&grid->plane, &changed))
+		return ASCIIGOL_BAD_DIMENSION;
+	grid->generation++;
+	return record_generation(grid, plane_hash(&grid->plane), changed ? ASCIIGOL_OK : ASCIIGOL_CONVERGED);
+}
+
+static asciigol_result_t jump_grid(grid_t* const grid, const uint64_t generations) {
+	if (grid->backend != ASCIIGOL_BACKEND_HASHLIFE || generations == 1) {
+		asciigol_result_t result = ASCIIGOL_OK;
+		for (uint64_t i = 0; i < generations && result == ASCIIGOL_OK; i++)
+			result = compute_grid(grid);
+		return result;
+	}
+
+	// the generations skipped at once are not a cycle, so start a new history
+	asciigol_result_t result = compute_universe(grid, generations);
+	if (result == ASCIIGOL_OK) {
+		cycle_clear(&grid->history);
+		grid->history_offset = grid->generation;
+		uint64_t start;
+		cycle_record(&grid->history, hashlife_hash(&grid->universe), &start);
+	}
+	return result;
+}
+
+static const cell_t* get_grid_row(grid_t* const grid, const uint32_t row) {
+	if (grid->backend == ASCIIGOL_BACKEND_BITBOARD) {
+		bitboard_unpack_row(&grid->board, row, grid->row_buffer);
+		return grid->row_buffer;
+	}
+	if (grid->backend == ASCIIGOL_BACKEND_HASHLIFE) {
+		hashlife_get_row(&grid->universe, 0, row, grid->width, grid->row_buffer);
+		return grid->row_buffer;
+	}
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE) {
+		plane_get_row(&grid->plane, grid->view_x, grid->view_y + row, grid->width, grid->row_buffer);
+		return grid->row_buffer;
+	}
+	return grid->cells + cell_index(grid->width, row, 0);
+}
+
+static void follow_plane(grid_t* const grid) {
+	int64_t x_min, y_min, x_max, y_max;
+	if (!plane_bounds(&grid->plane, &x_min, &y_min, &x_max, &y_max))
+		return;
+	const int64_t width = grid->width;
+	const int64_t height = grid->height;
+	if (x_max - x_min >= width)
+		grid->view_x = x_min + (x_max - x_min) / 2 - width / 2;
+	else if (x_min < grid->view_x)
+		grid->view_x = x_min;
+	else if (x_max >= grid->view_x + width)
+		grid->view_x = x_max - width + 1;
+	if (y_max - y_min >= height)
+		grid->view_y = y_min + (y_max - y_min) / 2 - height / 2;
+	else if (y_min < grid->view_y)
+		grid->view_y = y_min;
+	else if (y_max >= grid->view_y + height)
+		grid->view_y = y_max - height + 1;
+}
+
+static void capture_frame(grid_t* const grid, cell_t* const frame) {
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE)
+		follow_plane(grid);
+	for (uint32_t row = 0; row < grid->height; row++)
+		memcpy(frame + (size_t)grid->width * row, get_grid_row(grid, row), grid->width);
+}
+
+static void init_state_chars(
+	char* const state_chars,
 	const char live_char,
 	const char dead_char,
+	const uint16_t num_states
+) {
+	state_chars[0] = dead_char ? dead_char : DEFAULT_DEAD_CHAR;
+	state_chars[1] = live_char ? live_char : DEFAULT_LIVE_CHAR;
+	const size_t num_decay_chars = sizeof(DECAY_CHARS) - 1;
+	for (uint16_t state = 2; state < num_states; state++)
+		state_chars[state] = DECAY_CHARS[(size_t)(state - 2) * num_decay_chars / (num_states - 2)];
+}
+
+static void render_cells(
+	screen_t* const screen,
+	const cell_t* const frame,
+	const char* const state_chars,
 	const asciigol_bg_t background
 ) {
-	uint16_t size = width * height;
-	for (uint16_t i = 0; i < size; i++) {
-		const char live = live_char ? live_char : DEFAULT_LIVE_CHAR;
-		const char dead = dead_char ? dead_char : DEFAULT_DEAD_CHAR;
-		const bool are_chars_same = live == dead;
-		const bool is_live_cell = (bool)cells[i];
-		const bool alternate_bg = are_chars_same && !is_live_cell;
-		const char character = is_live_cell ? live : dead;
-		switch (background) {
-			case ASCIIGOL_BG_LIGHT:
-				printf("%s", alternate_bg ? BG_BLACK_FG_WHITE : BG_WHITE_FG_BLACK);
-				break;
-			case ASCIIGOL_BG_DARK:
-				printf("%s", alternate_bg ? BG_WHITE_FG_BLACK : BG_BLACK_FG_WHITE);
-				break;
-			case ASCIIGOL_BG_NONE:
-			default:
-				printf("%s", BG_DEFAULT_FG_DEFAULT);
+	const bool are_chars_same = state_chars[0] == state_chars[1];
+	for (uint32_t row = 0; row < screen->height; row++) {
+		const cell_t* const cells = frame + (size_t)screen->width * row;
+		char* const chars = screen->chars + (size_t)screen->width * row;
+		uint8_t* const colors = screen->colors + (size_t)screen->width * row;
+		for (uint32_t col = 0; col < screen->width; col++) {
+			const bool alternate_bg = are_chars_same && !cells[col];
+			chars[col] = state_chars[cells[col]];
+			switch (background) {
+				case ASCIIGOL_BG_LIGHT:
+					colors[col] = alternate_bg ? BG_BLACK_FG_WHITE : BG_WHITE_FG_BLACK;
+					break;
+				case ASCIIGOL_BG_DARK:
+					colors[col] = alternate_bg ? BG_WHITE_FG_BLACK : BG_BLACK_FG_WHITE;
+					break;
+				case ASCIIGOL_BG_NONE:
+				default:
+					colors[col] = BG_DEFAULT_FG_DEFAULT;
+			}
 		}
-		putchar(character);
-		if (i % width == width - 1)
-			printf("%s\n", BG_DEFAULT_FG_DEFAULT);
 	}
+	screen_present(screen);
 }
 
-static void destroy_cells(cell_t** cells, cell_t** back_buffer) {
-	free_buffer(cells);
-	free_buffer(back_buffer);
+static void* render_frames(void* context) {
+	renderer_t* const renderer = (renderer_t*)context;
+	grid_t* const grid = renderer->grid;
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	bool is_late = false;
+	bool was_dropped = false;
+	const cell_t* frame;
+	while ((frame = ring_begin_pop(&grid->frames))) {
+		was_dropped = is_late && !was_dropped;
+		uint64_t start = stats_start(renderer->stats);
+		if (!was_dropped) {
+			render_cells(&grid->screen, frame, renderer->state_chars, renderer->background);
+			start = stats_record(renderer->stats, STATS_RENDER, start);
+		}
+		ring_end_pop(&grid->frames);
+		advance_deadline(&deadline, renderer->delay);
+		is_late = !wait(&deadline);
+		stats_record(renderer->stats, STATS_WAIT, start);
+		if (is_late)
+			renderer->missed_deadlines++;
+	}
+	return NULL;
+}
+
+static uint64_t count_population(const grid_t* const grid) {
+	if (grid->backend == ASCIIGOL_BACKEND_BITBOARD)
+		return bitboard_population(&grid->board);
+	if (grid->backend == ASCIIGOL_BACKEND_HASHLIFE)
+		return hashlife_population(&grid->universe);
+	if (grid->backend == ASCIIGOL_BACKEND_PLANE)
+		return plane_population(&grid->plane);
+	uint64_t population = 0;
+	for (uint32_t row = 0; row < grid->height; row++) {
+		const cell_t* const cells = grid->cells + cell_index(grid->width, row, 0);
+		for (uint32_t col = 0; col < grid->width; col++)
+			population += cells[col] == 1;
+	}
+	return population;
 }
 
+static void destroy_grid(grid_t* const grid) {
+	destroy_cells(&grid->cells, &grid->back_buffer);
+	bitboard_destroy(&grid->board);
+	bitboard_destroy(&grid->back_board);
+	hashlife_destroy(&grid->universe);
+	plane_destroy(&grid->plane);
+	free(grid->active_tiles);
+	free(grid->changed_tiles);
+	free(grid->tile_hashes);
+	grid->active_tiles = NULL;
+	grid->changed_tiles = NULL;
+	grid->tile_hashes = NULL;
+	free_buffer(&grid->row_buffer);
+	if (grid->bands) {
+		threadpool_destroy(&grid->pool);
+		free(grid->bands);
+		grid->bands = NULL;
+	}
+	cycle_destroy(&grid->history);
+	ring_destroy(&grid->frames);
+	screen_destroy(&grid->screen);
+}
@@ -6,6 +6,8 @@
  */
 
 #include <asciigolgen.h>
+#include <rle.h>
+#include <screen.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -43,6 +45,23 @@ static const cell_t LIVE_CELL = '1';
  */
 static const cell_t DEAD_CELL = '0';
 
+/**
+ * @brief Colors of the rendered cells, indexing into `PALETTE`.
+ */
+typedef enum {
+	COLOR_DEFAULT,
+	COLOR_HIGHLIGHT
+} color_t;
+
+/**
+ * @brief ANSI control codes of each color: reset terminal attributes to
+ *        default, and green foreground for the highlighted cell.
+ */
+static const char* const PALETTE[] = {
+	"\x1b[0m",
+	"\x1b[32m"
+};
+
 /**
  * @brief The character indicating that the program should terminate.
  */
@@ -82,9 +101,10 @@ static struct termios terminal_noncanon(struct termios terminal);
 static void clear_screen();
 
 /**
- * @brief Reset the cursor to the top-left position.
+ * @brief Print the user instructions below the Game of Life grid.
+ * @param[in] height The height of the Game of Life grid.
  */
-static void reset_cursor();
+static void print_controls(const uint32_t height);
 
 /**
  * @brief Initialize the state of the Game of Life generator.
@@ -96,13 +116,15 @@ static void reset_cursor();
  */
 static asciigolgen_result_t init_state(
 	cell_t** const state,
-	const uint8_t width,
-	const uint8_t height,
+	const uint32_t width,
+	const uint32_t height,
 	const cell_t cell
 );
 
 /**
- * @brief Render the state of the Game of Life grid.
+ * @brief Render the state of the Game of Life grid, repainting only the cells
+ *        that changed since it was last rendered.
+ * @param[in,out] screen The screen to render to.
  * @param[in] state The Game of Life state to render.
  * @param[in] width The width of the Game of Life grid.
  * @param[in] height The height of the Game of Life grid.
@@ -110,10 +132,11 @@ static asciigolgen_result_t init_state(
  * @return The result of printing the Game of Life state.
  */
 static asciigolgen_result_t print_state(
+	screen_t* const screen,
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height,
-	const uint16_t highlight_idx
+	const uint32_t width,
+	const uint32_t height,
+	const size_t highlight_idx
 );
 
 /**
@@ -126,9 +149,9 @@ static asciigolgen_result_t print_state(
  */
 static asciigolgen_result_t process_input(
 	cell_t* state,
-	const uint8_t width,
-	const uint8_t height,
-	uint16_t* const highlight_idx
+	const uint32_t width,
+	const uint32_t height,
+	size_t* const highlight_idx
 );
 
 /**
@@ -141,12 +164,13 @@ static asciigolgen_result_t process_input(
  */
 static asciigolgen_result_t modify_state(
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height
+	const uint32_t width,
+	const uint32_t height
 );
 
 /**
- * @brief Write the Game of Life state to a configuration file.
+ * @brief Write the Game of Life state to a configuration file, run-length
+ *        encoded if its name ends in `.rle`.
  * @param[in] filename The name of a file to write the configuration to.
  * @param[in] state The Game of Life state to modify.
  * @param[in] width The width of the Game of Life grid.
@@ -157,8 +181,8 @@ static asciigolgen_result_t modify_state(
 static asciigolgen_result_t write_config(
 	char* const filename,
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height
+	const uint32_t width,
+	const uint32_t height
 );
 
 asciigolgen_result_t asciigolgen(asciigolgen_args_t args) {
@@ -200,53 +224,52 @@ static void clear_screen() {
 	printf("\x1b[2J");
 }
 
-static void reset_cursor() {
-	printf("\x1b[H");
+static void print_controls(const uint32_t height) {
+	printf("\x1b[%u;1H%s\n", height + 2, CONTROLS);
+	fflush(stdout);
 }
 
 static asciigolgen_result_t init_state(
 	cell_t** const state,
-	const uint8_t width,
-	const uint8_t height,
+	const uint32_t width,
+	const uint32_t height,
 	const cell_t cell
 ) {
 	if (cell != DEAD_CELL && cell != LIVE_CELL)
 		return ASCIIGOLGEN_INVAL;
-	const uint16_t size = width * height;
+	if (!width || !height || width > SIZE_MAX / height)
+		return ASCIIGOLGEN_INVAL;
+	const size_t size = (size_t)width * height;
 	*state = (cell_t*)malloc(size);
 	if (!*state)
 		return ASCIIGOLGEN_FAIL;
-	for (uint16_t i = 0; i < size; i++)
+	for (size_t i = 0; i < size; i++)
 		(*state)[i] = cell;
 	return ASCIIGOLGEN_OK;
 }
 
 static asciigolgen_result_t print_state(
+	screen_t* const screen,
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height,
-	const uint16_t highlight_idx
+	const uint32_t width,
+	const uint32_t height,
+	const size_t highlight_idx
 ) {
-	if (!state)
+	if (!screen || !state)
 		return ASCIIGOLGEN_INVAL;
-	const uint16_t size = width * height;
-	for (uint16_t i = 0; i < size; i++) {
-		if (i == highlight_idx)
-			printf("\x1b[32m%c\x1b[0m", state[i]);
-		else 
-			putchar(state[i]);
-		if (i % width == width - 1)
-			putchar('\n');
-	}
-	printf("\n%s\n", CONTROLS);
+	const size_t size = (size_t)width * height;
+	memcpy(screen->chars, state, size);
+	memset(screen->colors, COLOR_DEFAULT, size);
+	screen->colors[highlight_idx] = COLOR_HIGHLIGHT;
+	screen_present(screen);
 	return ASCIIGOLGEN_OK;
 }
 
 static asciigolgen_result_t process_input(
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height,
-	uint16_t* const highlight_idx
+	const uint32_t width,
+	const uint32_t height,
+	size_t* const highlight_idx
 ) {
 	if (!state || !highlight_idx)
 		return ASCIIGOLGEN_INVAL;
@@ -260,7 +283,7 @@ static asciigolgen_result_t process_input(
 	else if (c == '\x1b') { // ANSI escape code
 		getchar(); // skip [
 		char value = getchar();
-		const uint16_t size = width * height;
+		const size_t size = (size_t)width * height;
 		if (value == DIRECTION_UP && *highlight_idx >= width)
 			(*highlight_idx) -= width;
 		else if (value == DIRECTION_DOWN && *highlight_idx < size - width)
@@ -275,21 +298,26 @@ static asciigolgen_result_t process_input(
 
 static asciigolgen_result_t modify_state(
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height
+	const uint32_t width,
+	const uint32_t height
 ) {
 	if (!state)
 		return ASCIIGOLGEN_INVAL;
-	uint16_t highlight_idx = 0;
+	screen_t screen;
+	if (!screen_init(&screen, width, height, PALETTE, STDOUT_FILENO))
+		return ASCIIGOLGEN_FAIL;
+	size_t highlight_idx = 0;
 	asciigolgen_result_t result = ASCIIGOLGEN_OK;
 	clear_screen();
+	print_controls(height);
 	do {
-		reset_cursor();
-		result = print_state(state, width, height, highlight_idx);
+		result = print_state(&screen, state, width, height, highlight_idx);
 		if (result != ASCIIGOLGEN_OK)
-			return result;
+			break;
 		result = process_input(state, width, height, &highlight_idx);
 	} while (result == ASCIIGOLGEN_OK);
+	print_controls(height); // leave the cursor below the controls
+	screen_destroy(&screen);
 	return result;
 }
 
@@ -297,18 +325,24 @@ static asciigolgen_result_t modify_state(
 static asciigolgen_result_t write_config(
 	char* const filename,
 	cell_t* const state,
-	const uint8_t width,
-	const uint8_t height
+	const uint32_t width,
+	const uint32_t height
 ) {
 	if (!filename || !state)
 		return ASCIIGOLGEN_INVAL;
 	FILE* file = fopen(filename, "w");
 	if (!file)
 		return ASCIIGOLGEN_FAIL;
+	const char* const extension = strrchr(filename, '.');
+	if (extension && !strcmp(extension, ".rle")) {
+		const bool is_written = rle_write(file, (const uint8_t*)state, width, width, height, LIVE_CELL);
+		fclose(file);
+		return is_written ? ASCIIGOLGEN_OK : ASCIIGOLGEN_FAIL;
+	}
 	fwrite("asciigol\n", sizeof("asciigol\n") - 1, 1, file);
 	fprintf(file, "%u,%u\n", width, height);
-	const uint16_t size = width * height;
-	for (uint16_t i = 0; i < size; i++) {
+	const size_t size = (size_t)width * height;
+	for (size_t i = 0; i < size; i++) {
 		fputc(state[i], file);
 		if (i % width == width - 1)
 			fputc('\n', file);
@@ -0,0 +1,372 @@
+/**
+ * @file batch.c
+ * @brief Simulation of many independent Game of Life universes at once.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <batch.h>
+#include <parsing.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief The default number of generations after which a universe that has
+ *        neither converged nor cycled is given up on.
+ */
+static const uint64_t DEFAULT_GENERATIONS = 100000;
+
+/**
+ * @brief The result recorded for a universe given up on at the default
+ *        generation limit.
+ */
+static const char* const UNSTABILIZED_RESULT = "unstabilized";
+
+/**
+ * @brief The header line of the records.
+ */
+static const char* const RECORD_HEADER = "universe,result,generations,population,period,cycle_start";
+
+/**
+ * @brief One universe of the list along with the record of its simulation.
+ *
+ * The universe is random if `is_seed`, generated from `seed`, and otherwise
+ * loaded from the file named by `entry`. It `is_capped` if it was given up on
+ * at the default generation limit.
+ */
+typedef struct {
+	char* entry;
+	bool is_seed;
+	uint64_t seed;
+	asciigol_result_t result;
+	bool is_capped;
+	asciigol_summary_t summary;
+} universe_t;
+
+/**
+ * @brief The universes left to a worker: those from `begin` up to `end`.
+ *
+ * The worker takes universes from the beginning, whereas thieves steal them
+ * from the end, both under the lock.
+ */
+typedef struct {
+	pthread_mutex_t lock;
+	size_t begin;
+	size_t end;
+} deque_t;
+
+/**
+ * @brief A worker thread simulating universes one at a time on its engine.
+ */
+typedef struct batch_worker batch_worker_t;
+
+/**
+ * @brief The universes of a batch and the workers simulating them.
+ */
+typedef struct {
+	universe_t* universes;
+	size_t num_universes;
+	batch_worker_t* workers;
+	uint32_t num_workers;
+	asciigol_args_t args;
+} batch_t;
+
+struct batch_worker {
+	batch_t* batch;
+	uint32_t index;
+	deque_t deque;
+	asciigol_engine_t* engine;
+	pthread_t thread;
+};
+
+/**
+ * @brief Read the universes listed in a file.
+ * @param[in] list The name of the file listing the universes.
+ * @param[out] universes The universes read, to be freed with `free_universes`.
+ * @param[out] num_universes The number of universes read.
+ * @return True if the file was read, false otherwise.
+ */
+static bool read_universes(
+	const char* const list,
+	universe_t** const universes,
+	size_t* const num_universes
+);
+
+/**
+ * @brief Free the universes read from a list.
+ * @param[in,out] universes The universes.
+ * @param[in] num_universes The number of universes.
+ */
+static void free_universes(universe_t* const universes, const size_t num_universes);
+
+/**
+ * @brief Determine the number of workers simulating a batch.
+ * @param[in] threads The number of threads requested, zero denoting one per
+ *                    processor.
+ * @param[in] num_universes The number of universes, beyond which workers would
+ *                          idle.
+ * @return The number of workers, at least one.
+ */
+static uint32_t count_workers(const uint16_t threads, const size_t num_universes);
+
+/**
+ * @brief The loop executed by each worker thread until no universe is left.
+ * @param[in] arg The worker running the loop.
+ * @return Nothing.
+ */
+static void* run_worker(void* arg);
+
+/**
+ * @brief Take the next universe of a worker, stealing half of those left to
+ *        another worker if it has none of its own.
+ * @param[in,out] worker The worker.
+ * @param[out] index The index of the universe taken.
+ * @return True if a universe was taken, false if none is left.
+ */
+static bool take_universe(batch_worker_t* const worker, size_t* const index);
+
+/**
+ * @brief Steal the latter half of the universes left to a worker.
+ * @param[in,out] victim The worker stolen from.
+ * @param[out] begin The first universe stolen.
+ * @param[out] end One past the last universe stolen.
+ * @return True if any universe was stolen, false otherwise.
+ */
+static bool steal_universes(batch_worker_t* const victim, size_t* const begin, size_t* const end);
+
+/**
+ * @brief Simulate a universe on the engine of a worker until it converges,
+ *        cycles, or reaches the generation limit.
+ * @param[in,out] worker The worker.
+ * @param[in,out] universe The universe, into which its record is written.
+ */
+static void simulate_universe(batch_worker_t* const worker, universe_t* const universe);
+
+/**
+ * @brief Load a universe into the engine of a worker, creating the engine on
+ *        its first universe.
+ * @param[in,out] worker The worker.
+ * @param[in] universe The universe.
+ * @return The result of loading the universe.
+ */
+static asciigol_result_t load_universe(batch_worker_t* const worker, const universe_t* const universe);
+
+/**
+ * @brief Write the record of a universe as comma-separated values.
+ * @param[in,out] stream The stream to write to.
+ * @param[in] universe The universe.
+ */
+static void write_record(FILE* const stream, const universe_t* const universe);
+
+bool batch_run(const char* const list, asciigol_args_t args, FILE* const stream) {
+	batch_t batch = { 0 };
+	if (!read_universes(list, &batch.universes, &batch.num_universes))
+		return false;
+
+	// each universe is computed on a single thread, the workers being parallel
+	batch.args = args;
+	batch.args.filename = NULL;
+	batch.args.threads = 1;
+	batch.args.headless = true;
+	batch.num_workers = count_workers(args.threads, batch.num_universes);
+	batch.workers = (batch_worker_t*)calloc(batch.num_workers, sizeof(batch_worker_t));
+	if (!batch.workers) {
+		free_universes(batch.universes, batch.num_universes);
+		return false;
+	}
+
+	// the universes are dealt out in contiguous ranges, one per worker
+	for (uint32_t i = 0; i < batch.num_workers; i++) {
+		batch_worker_t* const worker = &batch.workers[i];
+		worker->batch = &batch;
+		worker->index = i;
+		worker->deque.begin = batch.num_universes * i / batch.num_workers;
+		worker->deque.end = batch.num_universes * (i + 1) / batch.num_workers;
+		pthread_mutex_init(&worker->deque.lock, NULL);
+	}
+	bool is_spawned = true;
+	uint32_t num_spawned = 1;
+	for (; num_spawned < batch.num_workers; num_spawned++) {
+		batch_worker_t* const worker = &batch.workers[num_spawned];
+		if (pthread_create(&worker->thread, NULL, run_worker, worker)) {
+			is_spawned = false;
+			break;
+		}
+	}
+
+	// the calling thread works as the first worker, and finishes the universes
+	// of any worker that failed to spawn by stealing them
+	run_worker(&batch.workers[0]);
+	for (uint32_t i = 1; i < num_spawned; i++)
+		pthread_join(batch.workers[i].thread, NULL);
+	for (uint32_t i = 0; i < batch.num_workers; i++)
+		pthread_mutex_destroy(&batch.workers[i].deque.lock);
+	free(batch.workers);
+	if (is_spawned) {
+		fprintf(stream, "%s\n", RECORD_HEADER);
+		for (size_t i = 0; i < batch.num_universes; i++)
+			write_record(stream, &batch.universes[i]);
+	}
+	free_universes(batch.universes, batch.num_universes);
+	return is_spawned;
+}
+
+static bool read_universes(
+	const char* const list,
+	universe_t** const universes,
+	size_t* const num_universes
+) {
+	FILE* const file = fopen(list, "r");
+	if (!file)
+		return false;
+	*universes = NULL;
+	*num_universes = 0;
+	size_t capacity = 0;
+	char* line = NULL;
+	size_t line_size = 0;
+	ssize_t length;
+	bool is_read = true;
+	while ((length = getline(&line, &line_size, file)) != -1) {
+		while (length && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+			line[--length] = '\0';
+		if (!length)
+			continue;
+		if (*num_universes == capacity) {
+			capacity = capacity ? capacity * 2 : 64;
+			universe_t* const grown = (universe_t*)realloc(*universes, capacity * sizeof(universe_t));
+			if (!grown) {
+				is_read = false;
+				break;
+			}
+			*universes = grown;
+		}
+		universe_t* const universe = &(*universes)[*num_universes];
+		memset(universe, 0, sizeof(universe_t));
+		universe->entry = strdup(line);
+		if (!universe->entry) {
+			is_read = false;
+			break;
+		}
+		// a seed of zero would be picked from the clock, so it and seeds out of
+		// range are taken for file names, recorded as bad files unless found
+		universe->is_seed = strspn(line, "0123456789") == (size_t)length &&
+		                    parse_uint64(line, &universe->seed) && universe->seed;
+		(*num_universes)++;
+	}
+	free(line);
+	fclose(file);
+	if (!is_read)
+		free_universes(*universes, *num_universes);
+	return is_read;
+}
+
+static void free_universes(universe_t* const universes, const size_t num_universes) {
+	for (size_t i = 0; i < num_universes; i++)
+		free(universes[i].entry);
+	free(universes);
+}
+
+static uint32_t count_workers(const uint16_t threads, const size_t num_universes) {
+	long num_workers = threads;
+	if (!num_workers)
+		num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+	if (num_workers < 1)
+		num_workers = 1;
+	if ((size_t)num_workers > num_universes)
+		num_workers = num_universes ? (long)num_universes : 1;
+	return (uint32_t)num_workers;
+}
+
+static void* run_worker(void* arg) {
+	batch_worker_t* const worker = (batch_worker_t*)arg;
+	size_t index;
+	while (take_universe(worker, &index))
+		simulate_universe(worker, &worker->batch->universes[index]);
+	asciigol_engine_destroy(worker->engine);
+	worker->engine = NULL;
+	return NULL;
+}
+
+static bool take_universe(batch_worker_t* const worker, size_t* const index) {
+	deque_t* const deque = &worker->deque;
+	pthread_mutex_lock(&deque->lock);
+	const bool is_taken = deque->begin < deque->end;
+	if (is_taken)
+		*index = deque->begin++;
+	pthread_mutex_unlock(&deque->lock);
+	if (is_taken)
+		return true;
+
+	// visit the other workers in turn, starting after this one so that
+	// thieves spread out over their victims
+	batch_t* const batch = worker->batch;
+	for (uint32_t i = 1; i < batch->num_workers; i++) {
+		batch_worker_t* const victim = &batch->workers[(worker->index + i) % batch->num_workers];
+		size_t begin, end;
+		if (!steal_universes(victim, &begin, &end))
+			continue;
+		pthread_mutex_lock(&deque->lock);
+		*index = begin;
+		deque->begin = begin + 1;
+		deque->end = end;
+		pthread_mutex_unlock(&deque->lock);
+		return true;
+	}
+	return false;
+}
+
+static bool steal_universes(batch_worker_t* const victim, size_t* const begin, size_t* const end) {
+	deque_t* const deque = &victim->deque;
+	pthread_mutex_lock(&deque->lock);
+	const size_t num_left = deque->end - deque->begin;
+	if (num_left) {
+		*end = deque->end;
+		deque->end -= (num_left + 1) / 2;
+		*begin = deque->end;
+	}
+	pthread_mutex_unlock(&deque->lock);
+	return num_left;
+}
+
+static void simulate_universe(batch_worker_t* const worker, universe_t* const universe) {
+	universe->result = load_universe(worker, universe);
+	if (universe->result != ASCIIGOL_OK)
+		return;
+
+	// one generation at a time, so the history of generations detects cycles
+	// with every backend, up to a default limit as escaping gliders and long
+	// cycles never repeat the grid
+	const uint64_t generations = worker->batch->args.generations;
+	const uint64_t limit = generations ? generations : DEFAULT_GENERATIONS;
+	asciigol_result_t result = ASCIIGOL_OK;
+	for (uint64_t generation = 0; result == ASCIIGOL_OK && generation < limit; generation++)
+		result = asciigol_engine_step(worker->engine, 1);
+	universe->result = result;
+	universe->is_capped = result == ASCIIGOL_OK && !generations;
+	asciigol_engine_summarize(worker->engine, &universe->summary);
+}
+
+static asciigol_result_t load_universe(batch_worker_t* const worker, const universe_t* const universe) {
+	if (!worker->engine) {
+		asciigol_args_t args = worker->batch->args;
+		if (universe->is_seed)
+			args.seed = universe->seed;
+		else
+			args.filename = universe->entry;
+		return asciigol_engine_create(&worker->engine, args);
+	}
+	if (universe->is_seed)
+		return asciigol_engine_reseed(worker->engine, universe->seed);
+	return asciigol_engine_load(worker->engine, universe->entry);
+}
+
+static void write_record(FILE* const stream, const universe_t* const universe) {
+	const asciigol_summary_t* const summary = &universe->summary;
+	const char* const result = universe->is_capped ? UNSTABILIZED_RESULT : asciigol_result_name(universe->result);
+	fprintf(stream, "%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu32 ",%" PRIu64 "\n",
+	        universe->entry, result, summary->generations,
+	        summary->population, summary->period, summary->cycle_start);
+}
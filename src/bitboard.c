@@ -0,0 +1,351 @@
+/**
+ * @file bitboard.c
+ * @brief Bit-packed Game of Life grid storing 64 cells per word.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <bitboard.h>
+#include <stdlib.h>
+
+/**
+ * @brief Retrieve the words of a row neighboring a given row.
+ * @param[in] board The bitboard to read from.
+ * @param[in] row The row whose neighbor is retrieved.
+ * @param[in] offset The offset of the neighbor: -1 (above) or 1 (below).
+ * @param[in] wrap Specify whether the top and bottom edges are connected.
+ * @return The words of the neighboring row, or NULL if there is none.
+ */
+static const uint64_t* neighbor_row(
+	const bitboard_t* const board,
+	const uint32_t row,
+	const int8_t offset,
+	const bool wrap
+);
+
+/**
+ * @brief Retrieve a word of a row with every cell shifted one column east,
+ *        such that bit c holds the cell at column c - 1.
+ * @param[in] board The bitboard the row belongs to.
+ * @param[in] words The words of the row.
+ * @param[in] index The index of the word within the row.
+ * @param[in] wrap Specify whether the left and right edges are connected.
+ * @return The shifted word.
+ */
+static uint64_t west_word(
+	const bitboard_t* const board,
+	const uint64_t* const words,
+	const size_t index,
+	const bool wrap
+);
+
+/**
+ * @brief Retrieve a word of a row with every cell shifted one column west,
+ *        such that bit c holds the cell at column c + 1.
+ * @param[in] board The bitboard the row belongs to.
+ * @param[in] words The words of the row.
+ * @param[in] index The index of the word within the row.
+ * @param[in] wrap Specify whether the left and right edges are connected.
+ * @return The shifted word.
+ */
+static uint64_t east_word(
+	const bitboard_t* const board,
+	const uint64_t* const words,
+	const size_t index,
+	const bool wrap
+);
+
+/**
+ * @brief Compute the next generation of a band of rows under a rule known at
+ *        compile time where the kind is constant.
+ * @param[in] kind The kind of the rule, as a constant, such that only its
+ *                 branch of the rule is compiled.
+ * @see bitboard_step_rows
+ */
+static inline bool step_rows(
+	const bitboard_t* const board,
+	bitboard_t* const new_board,
+	const bool wrap,
+	const rule_t* const rule,
+	const uint32_t row_begin,
+	const uint32_t row_end,
+	const rule_kind_t kind
+);
+
+/**
+ * @brief Compute 64 cells of the next generation at once under a rule known
+ *        at compile time where the kind is constant.
+ * @param[in] kind The kind of the rule, as a constant, such that only its
+ *                 branch of the rule is compiled.
+ * @see bitboard_compute_word
+ */
+static inline uint64_t compute_word(
+	const rule_t* const rule,
+	const rule_kind_t kind,
+	const uint64_t above_w,
+	const uint64_t above,
+	const uint64_t above_e,
+	const uint64_t west,
+	const uint64_t cells,
+	const uint64_t east,
+	const uint64_t below_w,
+	const uint64_t below,
+	const uint64_t below_e
+);
+
+bool bitboard_init(bitboard_t* const board, const uint32_t width, const uint32_t height) {
+	board->width = width;
+	board->height = height;
+
+	// rounded up in size_t, as the width may be within a word of UINT32_MAX
+	board->words_per_row = ((size_t)width + BITBOARD_WORD_BITS - 1) / BITBOARD_WORD_BITS;
+	board->words = NULL;
+	if (height && board->words_per_row > SIZE_MAX / sizeof(uint64_t) / height)
+		return false;
+	board->words = (uint64_t*)calloc(board->words_per_row * height, sizeof(uint64_t));
+	return board->words != NULL;
+}
+
+void bitboard_destroy(bitboard_t* const board) {
+	if (board->words) {
+		free(board->words);
+		board->words = NULL;
+	}
+}
+
+void bitboard_pack_row(
+	bitboard_t* const board,
+	const uint32_t row,
+	const uint8_t* const cells
+) {
+	uint64_t* const words = board->words + board->words_per_row * row;
+	for (size_t w = 0; w < board->words_per_row; w++)
+		words[w] = 0;
+	for (uint32_t c = 0; c < board->width; c++)
+		if (cells[c])
+			words[c / BITBOARD_WORD_BITS] |= (uint64_t)1 << (c % BITBOARD_WORD_BITS);
+}
+
+void bitboard_unpack_row(
+	const bitboard_t* const board,
+	const uint32_t row,
+	uint8_t* const cells
+) {
+	const uint64_t* const words = board->words + board->words_per_row * row;
+	for (uint32_t c = 0; c < board->width; c++)
+		cells[c] = (uint8_t)((words[c / BITBOARD_WORD_BITS] >> (c % BITBOARD_WORD_BITS)) & 1);
+}
+
+uint64_t bitboard_population(const bitboard_t* const board) {
+	uint64_t population = 0;
+	const size_t num_words = board->words_per_row * board->height;
+	for (size_t w = 0; w < num_words; w++)
+		population += (uint64_t)__builtin_popcountll(board->words[w]);
+	return population;
+}
+
+bool bitboard_step(
+	const bitboard_t* const board,
+	bitboard_t* const new_board,
+	const bool wrap,
+	const rule_t* const rule
+) {
+	return bitboard_step_rows(board, new_board, wrap, rule, 0, board->height);
+}
+
+bool bitboard_step_rows(
+	const bitboard_t* const board,
+	bitboard_t* const new_board,
+	const bool wrap,
+	const rule_t* const rule,
+	const uint32_t row_begin,
+	const uint32_t row_end
+) {
+	// pick the loop specialized for the rule once per band
+	switch (rule->kind) {
+		case RULE_LIFE:
+			return step_rows(board, new_board, wrap, rule, row_begin, row_end, RULE_LIFE);
+		case RULE_HIGHLIFE:
+			return step_rows(board, new_board, wrap, rule, row_begin, row_end, RULE_HIGHLIFE);
+		case RULE_DAY_AND_NIGHT:
+			return step_rows(board, new_board, wrap, rule, row_begin, row_end, RULE_DAY_AND_NIGHT);
+		default:
+			return step_rows(board, new_board, wrap, rule, row_begin, row_end, RULE_GENERIC);
+	}
+}
+
+uint64_t bitboard_compute_word(
+	const rule_t* const rule,
+	const uint64_t above_w,
+	const uint64_t above,
+	const uint64_t above_e,
+	const uint64_t west,
+	const uint64_t cells,
+	const uint64_t east,
+	const uint64_t below_w,
+	const uint64_t below,
+	const uint64_t below_e
+) {
+	return compute_word(rule, rule->kind, above_w, above, above_e, west, cells, east, below_w, below, below_e);
+}
+
+__attribute__((always_inline))
+static inline bool step_rows(
+	const bitboard_t* const board,
+	bitboard_t* const new_board,
+	const bool wrap,
+	const rule_t* const rule,
+	const uint32_t row_begin,
+	const uint32_t row_end,
+	const rule_kind_t kind
+) {
+	const size_t words_per_row = board->words_per_row;
+	const uint32_t tail_bits = board->width % BITBOARD_WORD_BITS;
+	const uint64_t tail_mask = tail_bits ? ((uint64_t)1 << tail_bits) - 1 : ~(uint64_t)0;
+	bool changed = false;
+	for (uint32_t r = row_begin; r < row_end; r++) {
+		const uint64_t* const above = neighbor_row(board, r, -1, wrap);
+		const uint64_t* const below = neighbor_row(board, r, 1, wrap);
+		const uint64_t* const cells = board->words + words_per_row * r;
+		uint64_t* const new_cells = new_board->words + words_per_row * r;
+		for (size_t w = 0; w < words_per_row; w++) {
+			uint64_t word = compute_word(
+				rule,
+				kind,
+				above ? west_word(board, above, w, wrap) : 0,
+				above ? above[w] : 0,
+				above ? east_word(board, above, w, wrap) : 0,
+				west_word(board, cells, w, wrap),
+				cells[w],
+				east_word(board, cells, w, wrap),
+				below ? west_word(board, below, w, wrap) : 0,
+				below ? below[w] : 0,
+				below ? east_word(board, below, w, wrap) : 0
+			);
+			if (w == words_per_row - 1)
+				word &= tail_mask;
+			if (word != cells[w])
+				changed = true;
+			new_cells[w] = word;
+		}
+	}
+	return changed;
+}
+
+__attribute__((always_inline))
+static inline uint64_t compute_word(
+	const rule_t* const rule,
+	const rule_kind_t kind,
+	const uint64_t above_w,
+	const uint64_t above,
+	const uint64_t above_e,
+	const uint64_t west,
+	const uint64_t cells,
+	const uint64_t east,
+	const uint64_t below_w,
+	const uint64_t below,
+	const uint64_t below_e
+) {
+	// full adders over the row above and the row below; half adder over the
+	// west and east neighbors of the current row
+	const uint64_t above_ones = above_w ^ above ^ above_e;
+	const uint64_t above_twos = (above_w & above) | (above_e & (above_w ^ above));
+	const uint64_t below_ones = below_w ^ below ^ below_e;
+	const uint64_t below_twos = (below_w & below) | (below_e & (below_w ^ below));
+	const uint64_t middle_ones = west ^ east;
+	const uint64_t middle_twos = west & east;
+
+	// combine the ones into the final ones bit, carrying into the twos
+	const uint64_t ones = above_ones ^ below_ones ^ middle_ones;
+	const uint64_t ones_carry = (above_ones & below_ones) | (middle_ones & (above_ones ^ below_ones));
+
+	// combine the twos into the final twos bit, carrying into the fours; both
+	// carries are only set together for a count of eight
+	const uint64_t twos_partial = above_twos ^ below_twos ^ middle_twos;
+	const uint64_t twos_carry = (above_twos & below_twos) | (middle_twos & (above_twos ^ below_twos));
+	const uint64_t twos = twos_partial ^ ones_carry;
+	const uint64_t partial_carry = twos_partial & ones_carry;
+	const uint64_t fours = twos_carry ^ partial_carry;
+	const uint64_t eights = twos_carry & partial_carry;
+
+	switch (kind) {
+		case RULE_LIFE:
+			// live with three neighbors, or two if already live
+			return twos & ~(twos_carry | partial_carry) & (ones | cells);
+		case RULE_HIGHLIFE: {
+			// Life, and also born with six neighbors
+			const uint64_t life = twos & ~(twos_carry | partial_carry) & (ones | cells);
+			return life | (~cells & ~ones & twos & fours);
+		}
+		case RULE_DAY_AND_NIGHT: {
+			// live with three or at least six neighbors, or four if already live
+			const uint64_t three = ones & twos & ~fours & ~eights;
+			const uint64_t four = cells & ~ones & ~twos & fours;
+			return three | four | (twos & fours) | eights;
+		}
+		default: {
+			// match the count against each count the rule names
+			uint64_t born = 0;
+			uint64_t survives = 0;
+			for (uint8_t n = 0; n <= 8; n++) {
+				if (!(((rule->birth | rule->survival) >> n) & 1))
+					continue;
+				const uint64_t is_count =
+					(n & 1 ? ones : ~ones) &
+					(n & 2 ? twos : ~twos) &
+					(n & 4 ? fours : ~fours) &
+					(n & 8 ? eights : ~eights);
+				if ((rule->birth >> n) & 1)
+					born |= is_count;
+				if ((rule->survival >> n) & 1)
+					survives |= is_count;
+			}
+			return (born & ~cells) | (survives & cells);
+		}
+	}
+}
+
+static const uint64_t* neighbor_row(
+	const bitboard_t* const board,
+	const uint32_t row,
+	const int8_t offset,
+	const bool wrap
+) {
+	int64_t neighbor = (int64_t)row + offset;
+	if (neighbor < 0 || neighbor >= board->height) {
+		if (!wrap)
+			return NULL;
+		neighbor = neighbor < 0 ? board->height - 1 : 0;
+	}
+	return board->words + board->words_per_row * (size_t)neighbor;
+}
+
+static uint64_t west_word(
+	const bitboard_t* const board,
+	const uint64_t* const words,
+	const size_t index,
+	const bool wrap
+) {
+	uint64_t word = words[index] << 1;
+	if (index)
+		word |= words[index - 1] >> (BITBOARD_WORD_BITS - 1);
+	else if (wrap) {
+		const uint32_t last = board->width - 1;
+		word |= (words[last / BITBOARD_WORD_BITS] >> (last % BITBOARD_WORD_BITS)) & 1;
+	}
+	return word;
+}
+
+static uint64_t east_word(
+	const bitboard_t* const board,
+	const uint64_t* const words,
+	const size_t index,
+	const bool wrap
+) {
+	uint64_t word = words[index] >> 1;
+	if (index + 1 < board->words_per_row)
+		word |= words[index + 1] << (BITBOARD_WORD_BITS - 1);
+	else if (wrap)
+		word |= (words[0] & 1) << ((board->width - 1) % BITBOARD_WORD_BITS);
+	return word;
+}
@@ -0,0 +1,964 @@
+/**
+ * @file census.c
+ * @brief Census of the objects left behind by random Game of Life soups.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <census.h>
+#include <cycle.h>
+#include <kernel.h>
+#include <rule.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief The default width and height of a soup.
+ */
+static const uint32_t DEFAULT_SOUP_SIZE = 16;
+
+/**
+ * @brief The default number of generations after which a soup that has not
+ *        stabilized is given up on.
+ */
+static const uint64_t DEFAULT_GENERATIONS = 20000;
+
+/**
+ * @brief The default longest period of the soups and objects detected.
+ */
+static const uint16_t DEFAULT_MAX_PERIOD = 64;
+
+/**
+ * @brief The number of generations between checks of whether the population
+ *        of a soup has become periodic.
+ */
+static const uint64_t CHECK_INTERVAL = 64;
+
+/**
+ * @brief The number of longest periods over which the population of a soup
+ *        must repeat for the soup to be considered stable.
+ */
+static const uint64_t STABLE_PERIODS = 4;
+
+/**
+ * @brief The number of generations whose live cells are merged before being
+ *        split into components, covering the periods of the oscillators
+ *        common in soups (2, 3 and 15).
+ */
+static const uint32_t MERGED_GENERATIONS = 32;
+
+/**
+ * @brief The number of cells the objects are given to move or grow into on
+ *        every side when simulated on their own, beyond a cell per two
+ *        generations.
+ */
+static const uint32_t OBJECT_MARGIN = 2;
+
+/**
+ * @brief Marker for an empty slot of a table of cells.
+ */
+static const uint32_t EMPTY_SLOT = UINT32_MAX;
+
+/**
+ * @brief Enumeration denoting the kind of an object.
+ */
+typedef enum {
+	CLASS_STILL_LIFE,
+	CLASS_OSCILLATOR,
+	CLASS_GLIDER,
+	CLASS_SPACESHIP,
+	CLASS_UNCLASSIFIED,
+} object_class_t;
+
+/**
+ * @brief The names of the classes, as written, indexed by class.
+ */
+static const char* const CLASS_NAMES[] = { "still_life", "oscillator", "glider", "spaceship", "unclassified" };
+
+/**
+ * @brief The header line of the frequency table.
+ */
+static const char* const TABLE_HEADER = "class,period,population,hash,count,seed";
+
+/**
+ * @brief An object of the ash of a soup, as identified by its canonical hash.
+ */
+typedef struct {
+	object_class_t class;
+	uint32_t period;
+	uint32_t population;
+	uint64_t hash;
+} object_t;
+
+/**
+ * @brief An entry of a table of objects, keyed by a nonzero hash.
+ *
+ * The census keys its tally by the canonical hash of the objects, counting
+ * them and remembering the seed of a soup they occurred in, whereas the
+ * workers key their memo of classified objects by the hash of a single phase
+ * and orientation.
+ */
+typedef struct {
+	uint64_t key;
+	object_t object;
+	uint64_t count;
+	uint64_t seed;
+} entry_t;
+
+/**
+ * @brief An open-addressed table of objects.
+ */
+typedef struct {
+	entry_t* entries;
+	size_t mask;
+	size_t num_entries;
+} table_t;
+
+/**
+ * @brief A cell of the ash, labelled by the component it belongs to.
+ */
+typedef struct {
+	uint32_t root;
+	int64_t y;
+	int64_t x;
+} labelled_cell_t;
+
+/**
+ * @brief A worker thread running soups one at a time on its engine.
+ *
+ * `populations` holds the population of every generation of the soup. The
+ * live cells of the merged generations are gathered into `xs` and `ys`,
+ * indexed by the open-addressed `slots` and linked by `parents` into a forest
+ * of components, and those of the first generation are `labelled` by their
+ * component. Objects are simulated on their own in `cells` and `back_cells`,
+ * and hashed through `keys`. The objects simulated are memoized into `memo`,
+ * and those found are tallied into `tally`. Every buffer is reused from one
+ * soup to the next.
+ */
+typedef struct census_worker census_worker_t;
+
+/**
+ * @brief The soups of a census and the workers running them.
+ */
+typedef struct {
+	census_worker_t* workers;
+	uint32_t num_workers;
+	asciigol_args_t args;
+	uint64_t num_soups;
+	uint64_t first_seed;
+	uint64_t generations;
+	uint16_t max_period;
+	kernel_t kernel;
+	atomic_uint_fast64_t next_soup;
+} census_t;
+
+struct census_worker {
+	census_t* census;
+	asciigol_engine_t* engine;
+	pthread_t thread;
+	uint64_t* populations;
+	size_t populations_capacity;
+	int64_t* xs;
+	int64_t* ys;
+	size_t cells_capacity;
+	uint32_t* slots;
+	size_t slots_capacity;
+	size_t slot_mask;
+	uint32_t* parents;
+	size_t parents_capacity;
+	labelled_cell_t* labelled;
+	size_t labelled_capacity;
+	uint64_t* keys;
+	size_t keys_capacity;
+	uint8_t* cells;
+	uint8_t* back_cells;
+	size_t grid_capacity;
+	table_t memo;
+	table_t tally;
+	uint64_t unstabilized;
+	bool is_failed;
+};
+
+/**
+ * @brief Determine the number of workers running a census.
+ * @param[in] threads The number of threads requested, zero denoting one per
+ *                    processor.
+ * @param[in] num_soups The number of soups, beyond which workers would idle.
+ * @return The number of workers, at least one.
+ */
+static uint32_t count_workers(const uint16_t threads, const uint64_t num_soups);
+
+/**
+ * @brief The loop executed by each worker thread until no soup is left.
+ * @param[in] arg The worker running the loop.
+ * @return Nothing.
+ */
+static void* run_worker(void* arg);
+
+/**
+ * @brief Run a soup until it stabilizes and tally the objects of its ash.
+ * @param[in,out] worker The worker.
+ * @param[in] seed The seed of the soup.
+ * @return True if the soup was run, false if memory ran out.
+ */
+static bool run_soup(census_worker_t* const worker, const uint64_t seed);
+
+/**
+ * @brief Advance the soup of a worker until it stabilizes or reaches the
+ *        generation limit.
+ * @param[in,out] worker The worker.
+ * @param[out] is_stable Whether the soup stabilized.
+ * @return True if the soup was advanced, false if memory ran out.
+ */
+static bool stabilize_soup(census_worker_t* const worker, bool* const is_stable);
+
+/**
+ * @brief Determine whether the recent populations of a soup repeat with a
+ *        period of at most the longest period.
+ * @param[in] populations The population of every generation.
+ * @param[in] num_generations The number of generations.
+ * @param[in] max_period The longest period.
+ * @return True if the populations repeat, false otherwise.
+ */
+static bool is_population_periodic(
+	const uint64_t* const populations,
+	const size_t num_generations,
+	const uint16_t max_period
+);
+
+/**
+ * @brief Append the live cells of the soup of a worker to its cells.
+ * @param[in,out] worker The worker.
+ * @param[in,out] num_cells The number of cells gathered so far.
+ * @return True if the cells were appended, false if memory ran out.
+ */
+static bool gather_cells(census_worker_t* const worker, size_t* const num_cells);
+
+/**
+ * @brief Split the cells of a worker into components, connecting every pair
+ *        of neighboring cells, and tally the objects of those holding cells
+ *        of the first generation.
+ * @param[in,out] worker The worker.
+ * @param[in] num_cells The number of cells of every merged generation.
+ * @param[in] num_first_cells The number of cells of the first generation,
+ *                            which come first.
+ * @param[in] seed The seed of the soup.
+ * @return True if the objects were tallied, false if memory ran out.
+ */
+static bool tally_components(
+	census_worker_t* const worker,
+	const size_t num_cells,
+	const size_t num_first_cells,
+	const uint64_t seed
+);
+
+/**
+ * @brief Index the distinct cells of a worker by their coordinates, moving
+ *        them to the front of its cells.
+ * @param[in,out] worker The worker.
+ * @param[in] num_cells The number of cells.
+ * @return The number of distinct cells.
+ */
+static size_t index_cells(census_worker_t* const worker, const size_t num_cells);
+
+/**
+ * @brief Find the cell of a worker at some coordinates.
+ * @param[in] worker The worker.
+ * @param[in] x The column of the cell.
+ * @param[in] y The row of the cell.
+ * @return The slot of the cell, or of the empty slot where it would be.
+ */
+static size_t find_cell(const census_worker_t* const worker, const int64_t x, const int64_t y);
+
+/**
+ * @brief Find the root of the component of a cell, halving the path to it.
+ * @param[in,out] parents The parent of every cell.
+ * @param[in] cell The cell.
+ * @return The root of the component.
+ */
+static uint32_t find_root(uint32_t* const parents, uint32_t cell);
+
+/**
+ * @brief Merge the components of two cells.
+ * @param[in,out] parents The parent of every cell.
+ * @param[in] a The first cell.
+ * @param[in] b The second cell.
+ */
+static void merge_components(uint32_t* const parents, const uint32_t a, const uint32_t b);
+
+/**
+ * @brief Order labelled cells by component, then row, then column.
+ * @param[in] a The first labelled cell.
+ * @param[in] b The second labelled cell.
+ * @return A negative, zero, or positive number as the first comes before,
+ *         with, or after the second.
+ */
+static int compare_labelled_cells(const void* a, const void* b);
+
+/**
+ * @brief Identify the object made of some cells, simulating it on its own
+ *        unless it has been before.
+ * @param[in,out] worker The worker.
+ * @param[in] cells The cells of the object, ordered by row, then column.
+ * @param[in] num_cells The number of cells.
+ * @param[out] object The object.
+ * @return True if the object was identified, false if memory ran out.
+ */
+static bool identify_object(
+	census_worker_t* const worker,
+	const labelled_cell_t* const cells,
+	const size_t num_cells,
+	object_t* const object
+);
+
+/**
+ * @brief Simulate an object on its own for up to the longest period to find
+ *        its period, whether it moves, and its canonical hash.
+ * @param[in,out] worker The worker.
+ * @param[in] cells The cells of the object, ordered by row, then column.
+ * @param[in] num_cells The number of cells.
+ * @param[out] object The object.
+ * @return True if the object was simulated, false if memory ran out.
+ */
+static bool classify_object(
+	census_worker_t* const worker,
+	const labelled_cell_t* const cells,
+	const size_t num_cells,
+	object_t* const object
+);
+
+/**
+ * @brief Hash the live cells of a grid relative to their bounding box, under
+ *        the rotation or reflection giving the least hash.
+ * @param[in,out] worker The worker, whose keys are used as scratch space.
+ * @param[in] cells The cells of the grid, with a one-cell halo.
+ * @param[in] width The width of the grid.
+ * @param[in] height The height of the grid.
+ * @return The canonical hash, never zero.
+ */
+static uint64_t hash_canonical(
+	census_worker_t* const worker,
+	const uint8_t* const cells,
+	const uint32_t width,
+	const uint32_t height
+);
+
+/**
+ * @brief Order 64-bit keys ascending.
+ * @param[in] a The first key.
+ * @param[in] b The second key.
+ * @return A negative, zero, or positive number as the first is less than,
+ *         equal to, or greater than the second.
+ */
+static int compare_keys(const void* a, const void* b);
+
+/**
+ * @brief Ensure a buffer has room for a number of elements, growing it by
+ *        doubling.
+ * @param[in,out] buffer The buffer.
+ * @param[in,out] capacity The number of elements there is room for.
+ * @param[in] needed The number of elements needed.
+ * @param[in] size The size of an element in bytes.
+ * @return True if there is room, false if memory ran out.
+ */
+static bool reserve(void** const buffer, size_t* const capacity, const size_t needed, const size_t size);
+
+/**
+ * @brief Find the entry of a table holding a key, inserting an empty one if
+ *        there is none, and growing the table as it fills.
+ * @param[in,out] table The table.
+ * @param[in] key The nonzero key.
+ * @return The entry, or NULL if memory ran out.
+ */
+static entry_t* find_entry(table_t* const table, const uint64_t key);
+
+/**
+ * @brief Order the entries of a tally, most frequent first.
+ * @param[in] a The first entry.
+ * @param[in] b The second entry.
+ * @return A negative, zero, or positive number as the first comes before,
+ *         with, or after the second.
+ */
+static int compare_entries(const void* a, const void* b);
+
+/**
+ * @brief Release the buffers of a worker.
+ * @param[in,out] worker The worker.
+ */
+static void destroy_worker(census_worker_t* const worker);
+
+asciigol_result_t census_run(const uint64_t num_soups, asciigol_args_t args, FILE* const stream) {
+	census_t census = { 0 };
+	rule_t rule;
+	if (!rule_parse(args.rule ? args.rule : RULE_CONWAY, &rule) || rule.num_states > 2)
+		return ASCIIGOL_BAD_RULE;
+
+	// every soup is run on a single thread in an unbounded plane
+	census.args = args;
+	census.args.filename = NULL;
+	census.args.threads = 1;
+	census.args.headless = true;
+	census.args.backend = ASCIIGOL_BACKEND_PLANE;
+	census.args.width = args.width ? args.width : DEFAULT_SOUP_SIZE;
+	census.args.height = args.height ? args.height : DEFAULT_SOUP_SIZE;
+	census.num_soups = num_soups;
+	census.first_seed = args.seed ? args.seed : (uint64_t)time(NULL) << 20;
+	census.generations = args.generations ? args.generations : DEFAULT_GENERATIONS;
+	census.max_period = args.max_period ? args.max_period : DEFAULT_MAX_PERIOD;
+	kernel_select(&census.kernel, rule);
+	atomic_init(&census.next_soup, 0);
+	census.num_workers = count_workers(args.threads, num_soups);
+	census.workers = (census_worker_t*)calloc(census.num_workers, sizeof(census_worker_t));
+	if (!census.workers)
+		return ASCIIGOL_BAD_DIMENSION;
+	for (uint32_t i = 0; i < census.num_workers; i++)
+		census.workers[i].census = &census;
+	bool is_spawned = true;
+	uint32_t num_spawned = 1;
+	for (; num_spawned < census.num_workers; num_spawned++)
+		if (pthread_create(&census.workers[num_spawned].thread, NULL, run_worker, &census.workers[num_spawned])) {
+			is_spawned = false;
+			break;
+		}
+
+	// the calling thread works as the first worker
+	run_worker(&census.workers[0]);
+	for (uint32_t i = 1; i < num_spawned; i++)
+		pthread_join(census.workers[i].thread, NULL);
+
+	// merge the tallies of the workers into that of the first
+	table_t* const tally = &census.workers[0].tally;
+	uint64_t unstabilized = 0;
+	bool is_run = is_spawned;
+	for (uint32_t i = 0; i < census.num_workers && is_run; i++) {
+		const census_worker_t* const worker = &census.workers[i];
+		is_run = !worker->is_failed;
+		unstabilized += worker->unstabilized;
+		if (!i)
+			continue;
+		for (size_t slot = 0; slot <= worker->tally.mask && worker->tally.entries && is_run; slot++) {
+			const entry_t* const source = &worker->tally.entries[slot];
+			if (!source->key)
+				continue;
+			entry_t* const entry = find_entry(tally, source->key);
+			if (!entry) {
+				is_run = false;
+				break;
+			}
+			if (!entry->count || source->seed < entry->seed) {
+				entry->object = source->object;
+				entry->seed = source->seed;
+			}
+			entry->count += source->count;
+		}
+	}
+
+	// write the table out of a compacted copy of the tally
+	entry_t* const entries = is_run ? (entry_t*)malloc((tally->num_entries + 1) * sizeof(entry_t)) : NULL;
+	if (entries) {
+		size_t num_entries = 0;
+		for (size_t slot = 0; tally->entries && slot <= tally->mask; slot++)
+			if (tally->entries[slot].key)
+				entries[num_entries++] = tally->entries[slot];
+		qsort(entries, num_entries, sizeof(entry_t), compare_entries);
+		fprintf(stream, "%s\n", TABLE_HEADER);
+		for (size_t i = 0; i < num_entries; i++) {
+			const object_t* const object = &entries[i].object;
+			fprintf(stream, "%s,%" PRIu32 ",%" PRIu32 ",%016" PRIx64 ",%" PRIu64 ",%" PRIu64 "\n",
+			        CLASS_NAMES[object->class], object->period, object->population,
+			        object->hash, entries[i].count, entries[i].seed);
+		}
+		if (unstabilized)
+			fprintf(stream, "unstabilized,0,0,%016" PRIx64 ",%" PRIu64 ",0\n", (uint64_t)0, unstabilized);
+		free(entries);
+	} else
+		is_run = false;
+	for (uint32_t i = 0; i < census.num_workers; i++)
+		destroy_worker(&census.workers[i]);
+	free(census.workers);
+	if (!is_spawned)
+		return ASCIIGOL_BAD_THREADS;
+	return is_run ? ASCIIGOL_OK : ASCIIGOL_BAD_DIMENSION;
+}
+
+static uint32_t count_workers(const uint16_t threads, const uint64_t num_soups) {
+	long num_workers = threads;
+	if (!num_workers)
+		num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+	if (num_workers < 1)
+		num_workers = 1;
+	if ((uint64_t)num_workers > num_soups)
+		num_workers = num_soups ? (long)num_soups : 1;
+	return (uint32_t)num_workers;
+}
+
+static void* run_worker(void* arg) {
+	census_worker_t* const worker = (census_worker_t*)arg;
+	census_t* const census = worker->census;
+	for (;;) {
+		const uint64_t soup = atomic_fetch_add_explicit(&census->next_soup, 1, memory_order_relaxed);
+		if (soup >= census->num_soups)
+			break;
+		const uint64_t seed = census->first_seed + soup;
+		if (!run_soup(worker, seed ? seed : 1)) {
+			worker->is_failed = true;
+			break;
+		}
+	}
+	asciigol_engine_destroy(worker->engine);
+	worker->engine = NULL;
+	return NULL;
+}
+
+static bool run_soup(census_worker_t* const worker, const uint64_t seed) {
+	census_t* const census = worker->census;
+	asciigol_result_t result;
+	if (worker->engine)
+		result = asciigol_engine_reseed(worker->engine, seed);
+	else {
+		asciigol_args_t args = census->args;
+		args.seed = seed;
+		result = asciigol_engine_create(&worker->engine, args);
+	}
+	if (result != ASCIIGOL_OK)
+		return false;
+	bool is_stable;
+	if (!stabilize_soup(worker, &is_stable))
+		return false;
+	if (!is_stable) {
+		worker->unstabilized++;
+		return true;
+	}
+
+	// the first generation comes first, followed by the cells of the
+	// generations merged with it
+	size_t num_cells = 0;
+	if (!gather_cells(worker, &num_cells))
+		return false;
+	const size_t num_first_cells = num_cells;
+	for (uint32_t generation = 1; generation < MERGED_GENERATIONS; generation++) {
+		asciigol_engine_step(worker->engine, 1);
+		if (!gather_cells(worker, &num_cells))
+			return false;
+	}
+	return tally_components(worker, num_cells, num_first_cells, seed);
+}
+
+static bool stabilize_soup(census_worker_t* const worker, bool* const is_stable) {
+	const census_t* const census = worker->census;
+	size_t num_generations = 0;
+	*is_stable = false;
+	while (num_generations < census->generations) {
+		const asciigol_result_t result = asciigol_engine_step(worker->engine, 1);
+		if (result == ASCIIGOL_CONVERGED || result == ASCIIGOL_CYCLED) {
+			*is_stable = true;
+			return true;
+		}
+		if (result != ASCIIGOL_OK)
+			return false;
+		if (!reserve((void**)&worker->populations, &worker->populations_capacity, num_generations + 1, sizeof(uint64_t)))
+			return false;
+		worker->populations[num_generations++] = asciigol_engine_population(worker->engine);
+
+		// gliders keep the plane from ever repeating, but not its population
+		if (num_generations % CHECK_INTERVAL == 0 &&
+		    is_population_periodic(worker->populations, num_generations, census->max_period)) {
+			*is_stable = true;
+			return true;
+		}
+	}
+	return true;
+}
+
+static bool is_population_periodic(
+	const uint64_t* const populations,
+	const size_t num_generations,
+	const uint16_t max_period
+) {
+	const size_t span = STABLE_PERIODS * max_period;
+	if (num_generations < span + max_period)
+		return false;
+	const uint64_t* const last = populations + num_generations - 1;
+	for (size_t period = 1; period <= max_period; period++) {
+		size_t i = 0;
+		while (i < span && last[-(ptrdiff_t)i] == last[-(ptrdiff_t)(i + period)])
+			i++;
+		if (i == span)
+			return true;
+	}
+	return false;
+}
+
+static bool gather_cells(census_worker_t* const worker, size_t* const num_cells) {
+	const size_t capacity = worker->cells_capacity - *num_cells;
+	size_t num_new_cells = asciigol_engine_get_live_cells(worker->engine, worker->xs + *num_cells, worker->ys + *num_cells, capacity);
+	if (num_new_cells > capacity) {
+		size_t xs_capacity = worker->cells_capacity;
+		if (!reserve((void**)&worker->xs, &xs_capacity, *num_cells + num_new_cells, sizeof(int64_t)) ||
+		    !reserve((void**)&worker->ys, &worker->cells_capacity, *num_cells + num_new_cells, sizeof(int64_t)))
+			return false;
+		asciigol_engine_get_live_cells(worker->engine, worker->xs + *num_cells, worker->ys + *num_cells, num_new_cells);
+	}
+	*num_cells += num_new_cells;
+	return true;
+}
+
+static bool tally_components(
+	census_worker_t* const worker,
+	const size_t num_cells,
+	const size_t num_first_cells,
+	const uint64_t seed
+) {
+	// the table of cells is kept at most half full
+	size_t num_slots = 64;
+	while (num_slots < num_cells * 2)
+		num_slots *= 2;
+	if (!reserve((void**)&worker->slots, &worker->slots_capacity, num_slots, sizeof(uint32_t)) ||
+	    !reserve((void**)&worker->parents, &worker->parents_capacity, num_cells, sizeof(uint32_t)) ||
+	    !reserve((void**)&worker->labelled, &worker->labelled_capacity, num_first_cells, sizeof(labelled_cell_t)))
+		return false;
+	worker->slot_mask = num_slots - 1;
+	const size_t num_distinct_cells = index_cells(worker, num_cells);
+
+	// neighbors are symmetric, so only those after each cell are visited
+	static const int64_t NEIGHBORS[][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+	for (size_t cell = 0; cell < num_distinct_cells; cell++)
+		worker->parents[cell] = (uint32_t)cell;
+	for (size_t cell = 0; cell < num_distinct_cells; cell++)
+		for (size_t n = 0; n < sizeof(NEIGHBORS) / sizeof(NEIGHBORS[0]); n++) {
+			const size_t slot = find_cell(worker, worker->xs[cell] + NEIGHBORS[n][0], worker->ys[cell] + NEIGHBORS[n][1]);
+			if (worker->slots[slot] != EMPTY_SLOT)
+				merge_components(worker->parents, (uint32_t)cell, worker->slots[slot]);
+		}
+
+	// the cells of the first generation are distinct, so they kept their place
+	for (size_t cell = 0; cell < num_first_cells; cell++) {
+		labelled_cell_t* const labelled = &worker->labelled[cell];
+		labelled->root = find_root(worker->parents, (uint32_t)cell);
+		labelled->x = worker->xs[cell];
+		labelled->y = worker->ys[cell];
+	}
+	qsort(worker->labelled, num_first_cells, sizeof(labelled_cell_t), compare_labelled_cells);
+	for (size_t begin = 0, end; begin < num_first_cells; begin = end) {
+		end = begin + 1;
+		while (end < num_first_cells && worker->labelled[end].root == worker->labelled[begin].root)
+			end++;
+		object_t object;
+		if (!identify_object(worker, worker->labelled + begin, end - begin, &object))
+			return false;
+		entry_t* const entry = find_entry(&worker->tally, object.hash);
+		if (!entry)
+			return false;
+		if (!entry->count || seed < entry->seed) {
+			entry->object = object;
+			entry->seed = seed;
+		}
+		entry->count++;
+	}
+	return true;
+}
+
+static size_t index_cells(census_worker_t* const worker, const size_t num_cells) {
+	memset(worker->slots, 0xFF, (worker->slot_mask + 1) * sizeof(uint32_t));
+	size_t num_distinct_cells = 0;
+	for (size_t cell = 0; cell < num_cells; cell++) {
+		const int64_t x = worker->xs[cell];
+		const int64_t y = worker->ys[cell];
+		const size_t slot = find_cell(worker, x, y);
+		if (worker->slots[slot] != EMPTY_SLOT)
+			continue;
+		worker->xs[num_distinct_cells] = x;
+		worker->ys[num_distinct_cells] = y;
+		worker->slots[slot] = (uint32_t)num_distinct_cells++;
+	}
+	return num_distinct_cells;
+}
+
+static size_t find_cell(const census_worker_t* const worker, const int64_t x, const int64_t y) {
+	const size_t mask = worker->slot_mask;
+	uint64_t hash = (uint64_t)x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)y * 0xC2B2AE3D27D4EB4FULL;
+	size_t slot = (size_t)(hash ^ hash >> 32) & mask;
+	for (;;) {
+		const uint32_t cell = worker->slots[slot];
+		if (cell == EMPTY_SLOT || (worker->xs[cell] == x && worker->ys[cell] == y))
+			return slot;
+		slot = (slot + 1) & mask;
+	}
+}
+
+static uint32_t find_root(uint32_t* const parents, uint32_t cell) {
+	while (parents[cell] != cell) {
+		parents[cell] = parents[parents[cell]];
+		cell = parents[cell];
+	}
+	return cell;
+}
+
+static void merge_components(uint32_t* const parents, const uint32_t a, const uint32_t b) {
+	const uint32_t root_a = find_root(parents, a);
+	const uint32_t root_b = find_root(parents, b);
+	if (root_a < root_b)
+		parents[root_b] = root_a;
+	else
+		parents[root_a] = root_b;
+}
+
+static int compare_labelled_cells(const void* a, const void* b) {
+	const labelled_cell_t* const cell_a = (const labelled_cell_t*)a;
+	const labelled_cell_t* const cell_b = (const labelled_cell_t*)b;
+	if (cell_a->root != cell_b->root)
+		return cell_a->root < cell_b->root ? -1 : 1;
+	if (cell_a->y != cell_b->y)
+		return cell_a->y < cell_b->y ? -1 : 1;
+	if (cell_a->x != cell_b->x)
+		return cell_a->x < cell_b->x ? -1 : 1;
+	return 0;
+}
+
+static bool identify_object(
+	census_worker_t* const worker,
+	const labelled_cell_t* const cells,
+	const size_t num_cells,
+	object_t* const object
+) {
+	// the cells are ordered, so their offsets from the bounding box identify
+	// the phase and orientation without sorting
+	if (!reserve((void**)&worker->keys, &worker->keys_capacity, num_cells, sizeof(uint64_t)))
+		return false;
+	int64_t x_min = cells[0].x;
+	for (size_t i = 1; i < num_cells; i++)
+		if (cells[i].x < x_min)
+			x_min = cells[i].x;
+	for (size_t i = 0; i < num_cells; i++)
+		worker->keys[i] = (uint64_t)(cells[i].y - cells[0].y) << 32 | (uint64_t)(cells[i].x - x_min);
+	const uint64_t key = cycle_hash(num_cells, worker->keys, num_cells * sizeof(uint64_t)) | 1;
+	entry_t* const entry = find_entry(&worker->memo, key);
+	if (!entry)
+		return false;
+	if (!entry->count) {
+		if (!classify_object(worker, cells, num_cells, &entry->object))
+			return false;
+		entry->count = 1;
+	}
+	*object = entry->object;
+	return true;
+}
+
+static bool classify_object(
+	census_worker_t* const worker,
+	const labelled_cell_t* const cells,
+	const size_t num_cells,
+	object_t* const object
+) {
+	const census_t* const census = worker->census;
+	int64_t x_min = cells[0].x, x_max = cells[0].x;
+	const int64_t y_min = cells[0].y, y_max = cells[num_cells - 1].y;
+	for (size_t i = 1; i < num_cells; i++) {
+		if (cells[i].x < x_min)
+			x_min = cells[i].x;
+		if (cells[i].x > x_max)
+			x_max = cells[i].x;
+	}
+
+	// leave room for the object to travel at half the speed of light, the
+	// fastest a spaceship can, for the longest period
+	const uint32_t margin = census->max_period / 2 + OBJECT_MARGIN;
+	const uint32_t width = (uint32_t)(x_max - x_min + 1) + margin * 2;
+	const uint32_t height = (uint32_t)(y_max - y_min + 1) + margin * 2;
+	const size_t stride = (size_t)width + 2;
+	const size_t size = stride * (height + 2);
+	size_t back_capacity = worker->grid_capacity;
+	if (!reserve((void**)&worker->keys, &worker->keys_capacity, size, sizeof(uint64_t)) ||
+	    !reserve((void**)&worker->back_cells, &back_capacity, size, sizeof(uint8_t)) ||
+	    !reserve((void**)&worker->cells, &worker->grid_capacity, size, sizeof(uint8_t)))
+		return false;
+	uint8_t* grid = worker->cells;
+	uint8_t* back_grid = worker->back_cells;
+	memset(grid, 0, size);
+	memset(back_grid, 0, size);
+	uint8_t* const origin = grid + stride + 1;
+	for (size_t i = 0; i < num_cells; i++)
+		origin[stride * (size_t)(cells[i].y - y_min + margin) + (size_t)(cells[i].x - x_min + margin)] = 1;
+
+	// step the object until a phase matches the first up to a translation,
+	// keeping the least canonical hash and population of the phases on the way
+	object->class = CLASS_UNCLASSIFIED;
+	object->period = 0;
+	object->population = (uint32_t)num_cells;
+	object->hash = hash_canonical(worker, grid, width, height);
+	for (uint32_t generation = 1; generation <= census->max_period; generation++) {
+		for (uint32_t row = 0; row < height; row++) {
+			const uint8_t* const row_cells = grid + stride * (row + 1) + 1;
+			census->kernel.row(&census->kernel, row_cells - stride, row_cells, row_cells + stride, back_grid + stride * (row + 1) + 1, width);
+		}
+		uint8_t* const temp = grid;
+		grid = back_grid;
+		back_grid = temp;
+
+		// the phase is compared to the first by its bounding box and cells
+		uint32_t population = 0;
+		int64_t phase_x_min = width, phase_x_max = -1, phase_y_min = height, phase_y_max = -1;
+		for (uint32_t row = 0; row < height; row++) {
+			const uint8_t* const row_cells = grid + stride * (row + 1) + 1;
+			for (uint32_t col = 0; col < width; col++) {
+				if (!row_cells[col])
+					continue;
+				population++;
+				if (col < phase_x_min)
+					phase_x_min = col;
+				if (col > phase_x_max)
+					phase_x_max = col;
+				if (row < phase_y_min)
+					phase_y_min = row;
+				phase_y_max = row;
+			}
+		}
+		if (!population || !phase_x_min || !phase_y_min || phase_x_max == width - 1 || phase_y_max == height - 1)
+			break;
+		if (population == num_cells &&
+		    phase_x_max - phase_x_min == x_max - x_min &&
+		    phase_y_max - phase_y_min == y_max - y_min) {
+			const int64_t dx = phase_x_min - margin;
+			const int64_t dy = phase_y_min - margin;
+			const uint8_t* const phase_origin = grid + stride * (size_t)(dy + 1) + (size_t)(dx + 1);
+			size_t i = 0;
+			while (i < num_cells && phase_origin[stride * (size_t)(cells[i].y - y_min + margin) + (size_t)(cells[i].x - x_min + margin)])
+				i++;
+			if (i == num_cells) {
+				object->period = generation;
+				if (dx || dy)
+					object->class = generation == 4 && num_cells == 5 ? CLASS_GLIDER : CLASS_SPACESHIP;
+				else
+					object->class = generation == 1 ? CLASS_STILL_LIFE : CLASS_OSCILLATOR;
+				break;
+			}
+		}
+		const uint64_t hash = hash_canonical(worker, grid, width, height);
+		if (hash < object->hash)
+			object->hash = hash;
+		if (population < object->population)
+			object->population = population;
+	}
+	return true;
+}
+
+static uint64_t hash_canonical(
+	census_worker_t* const worker,
+	const uint8_t* const cells,
+	const uint32_t width,
+	const uint32_t height
+) {
+	// the eight symmetries of the square, as the images of the x and y axes
+	static const int64_t SYMMETRIES[8][4] = {
+		{ 1, 0, 0, 1 }, { -1, 0, 0, 1 }, { 1, 0, 0, -1 }, { -1, 0, 0, -1 },
+		{ 0, 1, 1, 0 }, { 0, -1, 1, 0 }, { 0, 1, -1, 0 }, { 0, -1, -1, 0 },
+	};
+	const size_t stride = (size_t)width + 2;
+	uint64_t least = UINT64_MAX;
+	for (size_t s = 0; s < 8; s++) {
+		const int64_t* const symmetry = SYMMETRIES[s];
+		size_t num_cells = 0;
+		int64_t x_min = INT64_MAX, y_min = INT64_MAX;
+		for (uint32_t row = 0; row < height; row++) {
+			const uint8_t* const row_cells = cells + stride * (row + 1) + 1;
+			for (uint32_t col = 0; col < width; col++) {
+				if (!row_cells[col])
+					continue;
+				const int64_t x = symmetry[0] * col + symmetry[2] * row;
+				const int64_t y = symmetry[1] * col + symmetry[3] * row;
+				if (x < x_min)
+					x_min = x;
+				if (y < y_min)
+					y_min = y;
+				// stash the transformed cell, rebased once the minimum is known
+				worker->keys[num_cells++] = (uint64_t)(y + INT32_MAX) << 32 | (uint64_t)(x + INT32_MAX);
+			}
+		}
+		const uint64_t offset = (uint64_t)(y_min + INT32_MAX) << 32 | (uint64_t)(x_min + INT32_MAX);
+		for (size_t i = 0; i < num_cells; i++)
+			worker->keys[i] -= offset;
+		qsort(worker->keys, num_cells, sizeof(uint64_t), compare_keys);
+		const uint64_t hash = cycle_hash(num_cells, worker->keys, num_cells * sizeof(uint64_t));
+		if (hash < least)
+			least = hash;
+	}
+	return least | 1;
+}
+
+static int compare_keys(const void* a, const void* b) {
+	const uint64_t key_a = *(const uint64_t*)a;
+	const uint64_t key_b = *(const uint64_t*)b;
+	return key_a < key_b ? -1 : key_a > key_b;
+}
+
+static bool reserve(void** const buffer, size_t* const capacity, const size_t needed, const size_t size) {
+	if (needed <= *capacity)
+		return true;
+	size_t new_capacity = *capacity ? *capacity : 64;
+	while (new_capacity < needed)
+		new_capacity *= 2;
+	void* const grown = realloc(*buffer, new_capacity * size);
+	if (!grown)
+		return false;
+	*buffer = grown;
+	*capacity = new_capacity;
+	return true;
+}
+
+static entry_t* find_entry(table_t* const table, const uint64_t key) {
+	// keep the table at most half full
+	if (!table->entries || (table->num_entries + 1) * 2 > table->mask + 1) {
+		const size_t capacity = table->entries ? (table->mask + 1) * 2 : 256;
+		entry_t* const entries = (entry_t*)calloc(capacity, sizeof(entry_t));
+		if (!entries)
+			return NULL;
+		for (size_t slot = 0; table->entries && slot <= table->mask; slot++) {
+			const entry_t* const entry = &table->entries[slot];
+			if (!entry->key)
+				continue;
+			size_t new_slot = (size_t)entry->key & (capacity - 1);
+			while (entries[new_slot].key)
+				new_slot = (new_slot + 1) & (capacity - 1);
+			entries[new_slot] = *entry;
+		}
+		free(table->entries);
+		table->entries = entries;
+		table->mask = capacity - 1;
+	}
+	size_t slot = (size_t)key & table->mask;
+	while (table->entries[slot].key && table->entries[slot].key != key)
+		slot = (slot + 1) & table->mask;
+	entry_t* const entry = &table->entries[slot];
+	if (!entry->key) {
+		entry->key = key;
+		table->num_entries++;
+	}
+	return entry;
+}
+
+static int compare_entries(const void* a, const void* b) {
+	const entry_t* const entry_a = (const entry_t*)a;
+	const entry_t* const entry_b = (const entry_t*)b;
+	if (entry_a->count != entry_b->count)
+		return entry_a->count > entry_b->count ? -1 : 1;
+	return entry_a->key < entry_b->key ? -1 : entry_a->key > entry_b->key;
+}
+
+static void destroy_worker(census_worker_t* const worker) {
+	free(worker->populations);
+	free(worker->xs);
+	free(worker->ys);
+	free(worker->slots);
+	free(worker->parents);
+	free(worker->labelled);
+	free(worker->keys);
+	free(worker->cells);
+	free(worker->back_cells);
+	free(worker->memo.entries);
+	free(worker->tally.entries);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file cycle.c
+ * @brief Detection of periodic Game of Life generations by hashing.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <cycle.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Multiplier spreading each word across the hash.
+ */
+static const uint64_t HASH_PRIME_1 = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Multiplier mixing the hash after each word.
+ */
+static const uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+/**
+ * @brief Marker for an empty slot in the table of a cycle detector.
+ */
+static const uint64_t EMPTY_SLOT = UINT64_MAX;
+
+/**
+ * @brief Rotate a word left.
+ * @param[in] word The word to rotate.
+ * @param[in] bits The number of bits to rotate by, from 1 to 63.
+ * @return The rotated word.
+ */
+static uint64_t rotate_left(const uint64_t word, const uint8_t bits);
+
+/**
+ * @brief Fold a single word into a hash.
+ * @param[in] hash The hash to fold into.
+ * @param[in] word The word to fold.
+ * @return The updated hash.
+ */
+static uint64_t fold_word(const uint64_t hash, const uint64_t word);
+
+/**
+ * @brief Find the slot of the table holding a hash, or the empty slot where it
+ *        would be inserted.
+ * @param[in] detector The cycle detector.
+ * @param[in] hash The hash to find.
+ * @return The index of the slot.
+ */
+static size_t find_slot(const cycle_detector_t* const detector, const uint64_t hash);
+
+/**
+ * @brief Remove a hash from the table, shifting later entries of its probe
+ *        sequence back so no tombstones are needed.
+ * @param[in,out] detector The cycle detector.
+ * @param[in] slot The slot holding the hash to remove.
+ */
+static void remove_slot(cycle_detector_t* const detector, size_t slot);
+
+bool cycle_init(cycle_detector_t* const detector, const uint32_t max_period) {
+	// a period of max_period spans max_period + 1 generations
+	detector->max_period = max_period ? max_period : 1;
+	const size_t ring_size = (size_t)detector->max_period + 1;
+	size_t capacity = 2;
+	while (capacity < ring_size * 2)
+		capacity *= 2;
+	detector->num_generations = 0;
+	detector->table_mask = capacity - 1;
+	detector->ring = (uint64_t*)malloc(ring_size * sizeof(uint64_t));
+	detector->table_hashes = (uint64_t*)malloc(capacity * sizeof(uint64_t));
+	detector->table_generations = (uint64_t*)malloc(capacity * sizeof(uint64_t));
+	if (!detector->ring || !detector->table_hashes || !detector->table_generations) {
+		cycle_destroy(detector);
+		return false;
+	}
+	cycle_clear(detector);
+	return true;
+}
+
+uint32_t cycle_record(
+	cycle_detector_t* const detector,
+	const uint64_t hash,
+	uint64_t* const start
+) {
+	const uint64_t generation = detector->num_generations++;
+	const uint64_t ring_size = (uint64_t)detector->max_period + 1;
+	uint64_t* const ring_entry = &detector->ring[generation % ring_size];
+
+	// forget the generation falling out of the history, unless its hash has
+	// been seen again since, keeping the one max_period generations back
+	if (generation >= ring_size) {
+		const size_t slot = find_slot(detector, *ring_entry);
+		if (detector->table_generations[slot] == generation - ring_size)
+			remove_slot(detector, slot);
+	}
+	*ring_entry = hash;
+
+	// a repeated hash means the generations in between form a cycle
+	const size_t slot = find_slot(detector, hash);
+	uint32_t period = 0;
+	if (detector->table_generations[slot] != EMPTY_SLOT) {
+		*start = detector->table_generations[slot];
+		period = (uint32_t)(generation - *start);
+	}
+	detector->table_hashes[slot] = hash;
+	detector->table_generations[slot] = generation;
+	return period;
+}
+
+void cycle_clear(cycle_detector_t* const detector) {
+	detector->num_generations = 0;
+	for (size_t i = 0; i <= detector->table_mask; i++)
+		detector->table_generations[i] = EMPTY_SLOT;
+}
+
+void cycle_destroy(cycle_detector_t* const detector) {
+	free(detector->ring);
+	free(detector->table_hashes);
+	free(detector->table_generations);
+	detector->ring = NULL;
+	detector->table_hashes = NULL;
+	detector->table_generations = NULL;
+}
+
+uint64_t cycle_hash(uint64_t hash, const void* const data, const size_t size) {
+	const uint8_t* const bytes = (const uint8_t*)data;
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, bytes + i, sizeof(uint64_t));
+		hash = fold_word(hash, word);
+	}
+	if (i < size) {
+		uint64_t word = 0;
+		memcpy(&word, bytes + i, size - i);
+		hash = fold_word(hash, word);
+	}
+
+	// finalize so that every input bit affects every output bit
+	hash ^= hash >> 33;
+	hash *= HASH_PRIME_2;
+	hash ^= hash >> 29;
+	return hash;
+}
+
+static uint64_t rotate_left(const uint64_t word, const uint8_t bits) {
+	return (word << bits) | (word >> (64 - bits));
+}
+
+static uint64_t fold_word(const uint64_t hash, const uint64_t word) {
+	return rotate_left(hash ^ (word * HASH_PRIME_1), 31) * HASH_PRIME_2;
+}
+
+static size_t find_slot(const cycle_detector_t* const detector, const uint64_t hash) {
+	size_t slot = hash & detector->table_mask;
+	while (detector->table_generations[slot] != EMPTY_SLOT && detector->table_hashes[slot] != hash)
+		slot = (slot + 1) & detector->table_mask;
+	return slot;
+}
+
+static void remove_slot(cycle_detector_t* const detector, size_t slot) {
+	detector->table_generations[slot] = EMPTY_SLOT;
+	size_t next = (slot + 1) & detector->table_mask;
+	while (detector->table_generations[next] != EMPTY_SLOT) {
+		// move the entry back if its home slot does not lie between the hole
+		// and its current slot
+		const size_t home = detector->table_hashes[next] & detector->table_mask;
+		const size_t distance_home = (next - home) & detector->table_mask;
+		const size_t distance_hole = (next - slot) & detector->table_mask;
+		if (distance_home >= distance_hole) {
+			detector->table_hashes[slot] = detector->table_hashes[next];
+			detector->table_generations[slot] = detector->table_generations[next];
+			detector->table_generations[next] = EMPTY_SLOT;
+			slot = next;
+		}
+		next = (next + 1) & detector->table_mask;
+	}
+}
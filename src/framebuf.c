@@ -0,0 +1,109 @@
+/**
+ * @file framebuf.c
+ * @brief Reusable byte buffer assembling a frame for a single write.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <framebuf.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Make room for more bytes in a frame buffer, growing it if possible
+ *        and flushing it otherwise.
+ * @param[in,out] frame The frame buffer.
+ * @param[in] size The number of bytes to make room for.
+ * @return True if the bytes fit in the buffer, false if they must be written
+ *         directly.
+ */
+static bool reserve(framebuf_t* const frame, const size_t size);
+
+/**
+ * @brief Write bytes to a file descriptor, retrying partial writes.
+ * @param[in] fd The file descriptor to write to.
+ * @param[in] data The bytes to write.
+ * @param[in] size The number of bytes to write.
+ */
+static void write_all(const int fd, const char* data, size_t size);
+
+bool framebuf_init(framebuf_t* const frame, const size_t capacity, const int fd) {
+	frame->length = 0;
+	frame->capacity = capacity;
+	frame->fd = fd;
+	frame->data = (char*)malloc(capacity);
+	return frame->data != NULL;
+}
+
+void framebuf_clear(framebuf_t* const frame) {
+	frame->length = 0;
+}
+
+void framebuf_append(framebuf_t* const frame, const char* const data, const size_t size) {
+	if (!reserve(frame, size)) {
+		write_all(frame->fd, data, size);
+		return;
+	}
+	memcpy(frame->data + frame->length, data, size);
+	frame->length += size;
+}
+
+void framebuf_append_string(framebuf_t* const frame, const char* const string) {
+	framebuf_append(frame, string, strlen(string));
+}
+
+void framebuf_append_char(framebuf_t* const frame, const char character) {
+	if (frame->length == frame->capacity && !reserve(frame, 1)) {
+		write_all(frame->fd, &character, 1);
+		return;
+	}
+	frame->data[frame->length++] = character;
+}
+
+void framebuf_flush(framebuf_t* const frame) {
+	write_all(frame->fd, frame->data, frame->length);
+	frame->length = 0;
+}
+
+void framebuf_destroy(framebuf_t* const frame) {
+	if (frame->data) {
+		free(frame->data);
+		frame->data = NULL;
+	}
+	frame->length = 0;
+	frame->capacity = 0;
+}
+
+static bool reserve(framebuf_t* const frame, const size_t size) {
+	if (size <= frame->capacity - frame->length)
+		return true;
+	size_t capacity = frame->capacity ? frame->capacity : 1;
+	while (capacity - frame->length < size && capacity <= SIZE_MAX / 2)
+		capacity *= 2;
+	char* const data = capacity - frame->length >= size ? (char*)realloc(frame->data, capacity) : NULL;
+	if (data) {
+		frame->data = data;
+		frame->capacity = capacity;
+		return true;
+	}
+
+	// out of memory: write out what has been assembled so far instead
+	framebuf_flush(frame);
+	return size <= frame->capacity;
+}
+
+static void write_all(const int fd, const char* data, size_t size) {
+	while (size) {
+		const ssize_t written = write(fd, data, size);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+		data += written;
+		size -= (size_t)written;
+	}
+}
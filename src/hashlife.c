@@ -0,0 +1,701 @@
+/**
+ * @file hashlife.c
+ * @brief Unbounded Game of Life universe stepped with memoized quadtrees.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <hashlife.h>
+#include <stdlib.h>
+
+/**
+ * @brief Index denoting the absence of a node.
+ */
+static const uint32_t NIL = UINT32_MAX;
+
+/**
+ * @brief Index of the node of level zero representing a dead cell.
+ */
+static const uint32_t DEAD_CELL = 0;
+
+/**
+ * @brief Index of the node of level zero representing a live cell.
+ */
+static const uint32_t LIVE_CELL = 1;
+
+/**
+ * @brief Level marking a node of the store as free.
+ */
+static const uint8_t FREE_LEVEL = UINT8_MAX;
+
+/**
+ * @brief The level of the smallest root node, which is stepped by the base
+ *        case of the recursion at least once.
+ */
+static const uint8_t MIN_LEVEL = 3;
+
+/**
+ * @brief The number of nodes and buckets allocated up front.
+ */
+static const uint32_t INITIAL_CAPACITY = 1 << 16;
+
+/**
+ * @brief The number of nodes beyond which garbage is first collected.
+ */
+static const uint32_t INITIAL_GC_THRESHOLD = 1 << 20;
+
+/**
+ * @brief Multiplier spreading each word across the hash.
+ */
+static const uint64_t HASH_PRIME_1 = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Multiplier mixing the hash after each word.
+ */
+static const uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+/**
+ * @brief Fold a word into a hash.
+ * @param[in] hash The hash to fold into.
+ * @param[in] word The word to fold.
+ * @return The updated hash.
+ */
+static uint64_t mix(const uint64_t hash, const uint64_t word);
+
+/**
+ * @brief Take a node from the free list, or from the end of the store,
+ *        growing the store if it is full.
+ * @param[in,out] universe The universe whose store is allocated from.
+ * @return The index of the node, or NIL if the store cannot grow.
+ */
+static uint32_t alloc_node(hashlife_t* const universe);
+
+/**
+ * @brief Double the number of buckets of the hash table, keeping the current
+ *        buckets if the allocation fails.
+ * @param[in,out] universe The universe whose hash table is grown.
+ */
+static void grow_buckets(hashlife_t* const universe);
+
+/**
+ * @brief Retrieve the unique node with the given children, creating it if it
+ *        does not exist yet.
+ * @param[in,out] universe The universe.
+ * @param[in] nw The north-west child.
+ * @param[in] ne The north-east child.
+ * @param[in] sw The south-west child.
+ * @param[in] se The south-east child.
+ * @return The index of the node, or NIL if out of memory.
+ */
+static uint32_t join(
+	hashlife_t* const universe,
+	const uint32_t nw,
+	const uint32_t ne,
+	const uint32_t sw,
+	const uint32_t se
+);
+
+/**
+ * @brief Retrieve the node of a level whose cells are all dead.
+ * @param[in,out] universe The universe.
+ * @param[in] level The level of the node.
+ * @return The index of the node, or NIL if out of memory.
+ */
+static uint32_t empty(hashlife_t* const universe, const uint8_t level);
+
+/**
+ * @brief Retrieve the node of one level lower centered within a node.
+ * @param[in,out] universe The universe.
+ * @param[in] node The node of level two or higher.
+ * @return The index of the centered node, or NIL if out of memory.
+ */
+static uint32_t center(hashlife_t* const universe, const uint32_t node);
+
+/**
+ * @brief Determine whether every live cell of a node lies within its centered
+ *        square of a given depth.
+ * @param[in] universe The universe.
+ * @param[in] node The node of a level above the depth.
+ * @param[in] depth One for the centered square of half the size of the node,
+ *                  two for the centered square of a quarter of the size.
+ * @return True if the live cells are centered, false otherwise.
+ */
+static bool is_centered(const hashlife_t* const universe, const uint32_t node, const uint8_t depth);
+
+/**
+ * @brief Compute the center 2x2 cells of a 4x4 node one generation later.
+ * @param[in,out] universe The universe.
+ * @param[in] node The node of level two.
+ * @return The index of the resulting node of level one, or NIL if out of
+ *         memory.
+ */
+static uint32_t step_base(hashlife_t* const universe, const uint32_t node);
+
+/**
+ * @brief Compute the center of a node some generations later.
+ *
+ * A node of level k is advanced by 2^(k - 2) generations, or by 2^step_log2
+ * generations if that is fewer. Results are memoized in the node.
+ *
+ * @param[in,out] universe The universe.
+ * @param[in] node The node of level two or higher.
+ * @return The index of the resulting node of one level lower, or NIL if out of
+ *         memory.
+ */
+static uint32_t successor(hashlife_t* const universe, const uint32_t node);
+
+/**
+ * @brief Set the number of generations stepped at once, forgetting results
+ *        memoized for a different number.
+ * @param[in,out] universe The universe.
+ * @param[in] step_log2 The base-2 logarithm of the number of generations.
+ */
+static void set_step(hashlife_t* const universe, const uint8_t step_log2);
+
+/**
+ * @brief Surround the root with a border of dead cells, doubling its size.
+ * @param[in,out] universe The universe.
+ * @return True if the root was expanded, false if out of memory.
+ */
+static bool expand(hashlife_t* const universe);
+
+/**
+ * @brief Halve the size of the root for as long as no live cell is lost.
+ * @param[in,out] universe The universe.
+ * @return True if the root was shrunk, false if out of memory.
+ */
+static bool shrink(hashlife_t* const universe);
+
+/**
+ * @brief Advance a universe by a power of two generations.
+ * @param[in,out] universe The universe.
+ * @param[in] step_log2 The base-2 logarithm of the number of generations.
+ * @return True if the universe was advanced, false otherwise.
+ */
+static bool step_pow2(hashlife_t* const universe, const uint8_t step_log2);
+
+/**
+ * @brief Mark a node and every node below it as reachable.
+ * @param[in,out] universe The universe.
+ * @param[in] node The node to mark.
+ */
+static void mark(hashlife_t* const universe, const uint32_t node);
+
+/**
+ * @brief Free every node unreachable from the root, forgetting the results
+ *        memoized in reachable nodes that refer to freed ones.
+ * @param[in,out] universe The universe.
+ */
+static void collect_garbage(hashlife_t* const universe);
+
+/**
+ * @brief Build the node covering a square of a grid of cells.
+ * @param[in,out] universe The universe.
+ * @param[in] level The level of the node.
+ * @param[in] x The column of the top-left cell of the square.
+ * @param[in] y The row of the top-left cell of the square.
+ * @param[in] cells The cells of the grid.
+ * @param[in] stride The distance between the first cells of adjacent rows.
+ * @param[in] width The width of the grid.
+ * @param[in] height The height of the grid.
+ * @return The index of the node, or NIL if out of memory.
+ */
+static uint32_t build(
+	hashlife_t* const universe,
+	const uint8_t level,
+	const uint64_t x,
+	const uint64_t y,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height
+);
+
+/**
+ * @brief Read the live cells of a node lying on a span of a row.
+ * @param[in] universe The universe.
+ * @param[in] node The node to read.
+ * @param[in] node_x The column of the top-left cell of the node.
+ * @param[in] node_y The row of the top-left cell of the node.
+ * @param[in] x The column of the first cell of the span.
+ * @param[in] y The row of the span.
+ * @param[in] width The number of cells in the span.
+ * @param[out] cells The cells of the span, whose live cells are set to one.
+ */
+static void read_row(
+	const hashlife_t* const universe,
+	const uint32_t node,
+	const int64_t node_x,
+	const int64_t node_y,
+	const int64_t x,
+	const int64_t y,
+	const uint32_t width,
+	uint8_t* const cells
+);
+
+bool hashlife_init(
+	hashlife_t* const universe,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height,
+	const rule_t rule
+) {
+	universe->rule = rule;
+	universe->num_nodes = 2;
+	universe->num_free_nodes = 0;
+	universe->capacity = INITIAL_CAPACITY;
+	universe->free_node = NIL;
+	universe->bucket_mask = INITIAL_CAPACITY - 1;
+	universe->gc_threshold = INITIAL_GC_THRESHOLD;
+	universe->origin_x = 0;
+	universe->origin_y = 0;
+	universe->step_log2 = 0;
+	universe->nodes = (hashlife_node_t*)malloc(INITIAL_CAPACITY * sizeof(hashlife_node_t));
+	universe->buckets = (uint32_t*)malloc(INITIAL_CAPACITY * sizeof(uint32_t));
+	if (!universe->nodes || !universe->buckets) {
+		hashlife_destroy(universe);
+		return false;
+	}
+	for (uint32_t i = 0; i < INITIAL_CAPACITY; i++)
+		universe->buckets[i] = NIL;
+	for (uint8_t level = 0; level <= HASHLIFE_MAX_LEVEL; level++)
+		universe->empty[level] = NIL;
+
+	// the two cells are the leaves of every quadtree
+	const hashlife_node_t dead = { NIL, NIL, NIL, NIL, NIL, NIL, 0, mix(0, 0), 0, false };
+	const hashlife_node_t live = { NIL, NIL, NIL, NIL, NIL, NIL, 1, mix(0, 1), 0, false };
+	universe->nodes[DEAD_CELL] = dead;
+	universe->nodes[LIVE_CELL] = live;
+	universe->empty[0] = DEAD_CELL;
+
+	uint8_t level = MIN_LEVEL;
+	while (((uint64_t)1 << level) < width || ((uint64_t)1 << level) < height)
+		level++;
+	universe->root = build(universe, level, 0, 0, cells, stride, width, height);
+	if (universe->root == NIL || !shrink(universe)) {
+		hashlife_destroy(universe);
+		return false;
+	}
+	return true;
+}
+
+void hashlife_destroy(hashlife_t* const universe) {
+	free(universe->nodes);
+	free(universe->buckets);
+	universe->nodes = NULL;
+	universe->buckets = NULL;
+}
+
+bool hashlife_step(hashlife_t* const universe, const uint64_t generations) {
+	for (uint8_t bit = 0; bit < 64; bit++)
+		if ((generations >> bit) & 1 && !step_pow2(universe, bit))
+			return false;
+	return true;
+}
+
+void hashlife_get_row(
+	const hashlife_t* const universe,
+	const int64_t x,
+	const int64_t y,
+	const uint32_t width,
+	uint8_t* const cells
+) {
+	for (uint32_t col = 0; col < width; col++)
+		cells[col] = 0;
+	read_row(universe, universe->root, universe->origin_x, universe->origin_y, x, y, width, cells);
+}
+
+uint64_t hashlife_population(const hashlife_t* const universe) {
+	return universe->nodes[universe->root].population;
+}
+
+uint64_t hashlife_hash(const hashlife_t* const universe) {
+	uint64_t hash = mix(universe->nodes[universe->root].hash, (uint64_t)universe->origin_x);
+	return mix(hash, (uint64_t)universe->origin_y);
+}
+
+static uint64_t mix(const uint64_t hash, const uint64_t word) {
+	const uint64_t mixed = hash ^ (word * HASH_PRIME_1);
+	return ((mixed << 31) | (mixed >> 33)) * HASH_PRIME_2;
+}
+
+static uint32_t alloc_node(hashlife_t* const universe) {
+	if (universe->free_node != NIL) {
+		const uint32_t node = universe->free_node;
+		universe->free_node = universe->nodes[node].next;
+		universe->num_free_nodes--;
+		return node;
+	}
+	if (universe->num_nodes == universe->capacity) {
+		if (universe->capacity > (NIL - 1) / 2)
+			return NIL;
+		const uint32_t capacity = universe->capacity * 2;
+		hashlife_node_t* const nodes = (hashlife_node_t*)realloc(universe->nodes, capacity * sizeof(hashlife_node_t));
+		if (!nodes)
+			return NIL;
+		universe->nodes = nodes;
+		universe->capacity = capacity;
+	}
+	return universe->num_nodes++;
+}
+
+static void grow_buckets(hashlife_t* const universe) {
+	if (universe->bucket_mask >= (NIL >> 1))
+		return;
+	const uint32_t num_buckets = (universe->bucket_mask + 1) * 2;
+	uint32_t* const buckets = (uint32_t*)malloc(num_buckets * sizeof(uint32_t));
+	if (!buckets)
+		return;
+	for (uint32_t i = 0; i < num_buckets; i++)
+		buckets[i] = NIL;
+	for (uint32_t i = LIVE_CELL + 1; i < universe->num_nodes; i++) {
+		hashlife_node_t* const node = &universe->nodes[i];
+		if (node->level == FREE_LEVEL)
+			continue;
+		const uint32_t slot = (uint32_t)(node->hash & (num_buckets - 1));
+		node->next = buckets[slot];
+		buckets[slot] = i;
+	}
+	free(universe->buckets);
+	universe->buckets = buckets;
+	universe->bucket_mask = num_buckets - 1;
+}
+
+static uint32_t join(
+	hashlife_t* const universe,
+	const uint32_t nw,
+	const uint32_t ne,
+	const uint32_t sw,
+	const uint32_t se
+) {
+	if (nw == NIL || ne == NIL || sw == NIL || se == NIL)
+		return NIL;
+	const hashlife_node_t* const nodes = universe->nodes;
+	const uint8_t level = nodes[nw].level + 1;
+	uint64_t hash = mix(level, nodes[nw].hash);
+	hash = mix(hash, nodes[ne].hash);
+	hash = mix(hash, nodes[sw].hash);
+	hash = mix(hash, nodes[se].hash);
+	hash ^= hash >> 32;
+
+	// nodes are hash-consed: an identical node is reused rather than created
+	const uint32_t slot = (uint32_t)(hash & universe->bucket_mask);
+	for (uint32_t i = universe->buckets[slot]; i != NIL; i = nodes[i].next)
+		if (nodes[i].hash == hash && nodes[i].nw == nw && nodes[i].ne == ne && nodes[i].sw == sw && nodes[i].se == se)
+			return i;
+
+	const uint32_t node = alloc_node(universe);
+	if (node == NIL)
+		return NIL;
+	hashlife_node_t* const new_node = &universe->nodes[node];
+	new_node->nw = nw;
+	new_node->ne = ne;
+	new_node->sw = sw;
+	new_node->se = se;
+	new_node->result = NIL;
+	new_node->next = universe->buckets[slot];
+	new_node->population = universe->nodes[nw].population + universe->nodes[ne].population +
+		universe->nodes[sw].population + universe->nodes[se].population;
+	new_node->hash = hash;
+	new_node->level = level;
+	new_node->is_marked = false;
+	universe->buckets[slot] = node;
+	if (universe->num_nodes - universe->num_free_nodes > universe->bucket_mask + 1)
+		grow_buckets(universe);
+	return node;
+}
+
+static uint32_t empty(hashlife_t* const universe, const uint8_t level) {
+	if (universe->empty[level] == NIL) {
+		const uint32_t child = empty(universe, level - 1);
+		universe->empty[level] = join(universe, child, child, child, child);
+	}
+	return universe->empty[level];
+}
+
+static uint32_t center(hashlife_t* const universe, const uint32_t node) {
+	const hashlife_node_t* const nodes = universe->nodes;
+	const hashlife_node_t* const n = &nodes[node];
+	return join(universe, nodes[n->nw].se, nodes[n->ne].sw, nodes[n->sw].ne, nodes[n->se].nw);
+}
+
+static bool is_centered(const hashlife_t* const universe, const uint32_t node, const uint8_t depth) {
+	const hashlife_node_t* const nodes = universe->nodes;
+	const hashlife_node_t* const n = &nodes[node];
+	uint32_t nw = nodes[n->nw].se;
+	uint32_t ne = nodes[n->ne].sw;
+	uint32_t sw = nodes[n->sw].ne;
+	uint32_t se = nodes[n->se].nw;
+	for (uint8_t i = 1; i < depth; i++) {
+		nw = nodes[nw].se;
+		ne = nodes[ne].sw;
+		sw = nodes[sw].ne;
+		se = nodes[se].nw;
+	}
+	const uint64_t population = nodes[nw].population + nodes[ne].population +
+		nodes[sw].population + nodes[se].population;
+	return population == n->population;
+}
+
+static uint32_t step_base(hashlife_t* const universe, const uint32_t node) {
+	// gather the 4x4 cells into a bit per cell, row by row
+	const hashlife_node_t* const nodes = universe->nodes;
+	const hashlife_node_t* const n = &nodes[node];
+	const uint32_t quadrants[4] = { n->nw, n->ne, n->sw, n->se };
+	uint16_t bits = 0;
+	for (uint8_t q = 0; q < 4; q++) {
+		const hashlife_node_t* const quadrant = &nodes[quadrants[q]];
+		const uint8_t x = (q % 2) * 2;
+		const uint8_t y = (q / 2) * 2;
+		bits |= (uint16_t)(nodes[quadrant->nw].population << (y * 4 + x));
+		bits |= (uint16_t)(nodes[quadrant->ne].population << (y * 4 + x + 1));
+		bits |= (uint16_t)(nodes[quadrant->sw].population << ((y + 1) * 4 + x));
+		bits |= (uint16_t)(nodes[quadrant->se].population << ((y + 1) * 4 + x + 1));
+	}
+
+	uint32_t cells[4];
+	for (uint8_t i = 0; i < 4; i++) {
+		const uint8_t x = 1 + i % 2;
+		const uint8_t y = 1 + i / 2;
+		uint8_t neighbors = 0;
+		for (int8_t dy = -1; dy <= 1; dy++)
+			for (int8_t dx = -1; dx <= 1; dx++)
+				if (dx || dy)
+					neighbors += (bits >> ((y + dy) * 4 + x + dx)) & 1;
+		const bool is_live = (bits >> (y * 4 + x)) & 1;
+		cells[i] = rule_apply(&universe->rule, is_live, neighbors) ? LIVE_CELL : DEAD_CELL;
+	}
+	return join(universe, cells[0], cells[1], cells[2], cells[3]);
+}
+
+static uint32_t successor(hashlife_t* const universe, const uint32_t node) {
+	const hashlife_node_t* const n = &universe->nodes[node];
+	if (n->result != NIL)
+		return n->result;
+	const uint8_t level = n->level;
+	uint32_t result;
+	if (!n->population)
+		result = empty(universe, level - 1);
+	else if (level == 2)
+		result = step_base(universe, node);
+	else {
+		// the 16 grandchildren, row by row
+		uint32_t grandchildren[4][4];
+		const uint32_t children[4] = { n->nw, n->ne, n->sw, n->se };
+		for (uint8_t c = 0; c < 4; c++) {
+			const hashlife_node_t* const child = &universe->nodes[children[c]];
+			const uint8_t x = (c % 2) * 2;
+			const uint8_t y = (c / 2) * 2;
+			grandchildren[y][x] = child->nw;
+			grandchildren[y][x + 1] = child->ne;
+			grandchildren[y + 1][x] = child->sw;
+			grandchildren[y + 1][x + 1] = child->se;
+		}
+
+		// advance the 9 overlapping subnodes of half the size, then combine
+		// them into 4 that are advanced again, or just centered if the step is
+		// already complete
+		uint32_t advanced[3][3];
+		for (uint8_t y = 0; y < 3; y++)
+			for (uint8_t x = 0; x < 3; x++) {
+				const uint32_t subnode = join(
+					universe,
+					grandchildren[y][x],
+					grandchildren[y][x + 1],
+					grandchildren[y + 1][x],
+					grandchildren[y + 1][x + 1]
+				);
+				if (subnode == NIL)
+					return NIL;
+				advanced[y][x] = successor(universe, subnode);
+				if (advanced[y][x] == NIL)
+					return NIL;
+			}
+		const bool is_full_step = universe->step_log2 + 2 >= level;
+		uint32_t quadrants[4];
+		for (uint8_t q = 0; q < 4; q++) {
+			const uint8_t x = q % 2;
+			const uint8_t y = q / 2;
+			const uint32_t combined = join(
+				universe,
+				advanced[y][x],
+				advanced[y][x + 1],
+				advanced[y + 1][x],
+				advanced[y + 1][x + 1]
+			);
+			if (combined == NIL)
+				return NIL;
+			quadrants[q] = is_full_step ? successor(universe, combined) : center(universe, combined);
+		}
+		result = join(universe, quadrants[0], quadrants[1], quadrants[2], quadrants[3]);
+	}
+	if (result != NIL)
+		universe->nodes[node].result = result;
+	return result;
+}
+
+static void set_step(hashlife_t* const universe, const uint8_t step_log2) {
+	if (step_log2 == universe->step_log2)
+		return;
+
+	// nodes small enough to be advanced by their full step are unaffected
+	const uint8_t min_step_log2 = step_log2 < universe->step_log2 ? step_log2 : universe->step_log2;
+	for (uint32_t i = LIVE_CELL + 1; i < universe->num_nodes; i++) {
+		hashlife_node_t* const node = &universe->nodes[i];
+		if (node->level != FREE_LEVEL && node->level > min_step_log2 + 2)
+			node->result = NIL;
+	}
+	universe->step_log2 = step_log2;
+}
+
+static bool expand(hashlife_t* const universe) {
+	const hashlife_node_t root = universe->nodes[universe->root];
+	if (root.level >= HASHLIFE_MAX_LEVEL)
+		return false;
+	const uint32_t border = empty(universe, root.level - 1);
+	const uint32_t nw = join(universe, border, border, border, root.nw);
+	const uint32_t ne = join(universe, border, border, root.ne, border);
+	const uint32_t sw = join(universe, border, root.sw, border, border);
+	const uint32_t se = join(universe, root.se, border, border, border);
+	const uint32_t expanded = join(universe, nw, ne, sw, se);
+	if (expanded == NIL)
+		return false;
+	universe->root = expanded;
+	universe->origin_x -= (int64_t)1 << (root.level - 1);
+	universe->origin_y -= (int64_t)1 << (root.level - 1);
+	return true;
+}
+
+static bool shrink(hashlife_t* const universe) {
+	while (universe->nodes[universe->root].level > MIN_LEVEL && is_centered(universe, universe->root, 1)) {
+		const uint8_t level = universe->nodes[universe->root].level;
+		const uint32_t centered = center(universe, universe->root);
+		if (centered == NIL)
+			return false;
+		universe->root = centered;
+		universe->origin_x += (int64_t)1 << (level - 2);
+		universe->origin_y += (int64_t)1 << (level - 2);
+	}
+	return true;
+}
+
+static bool step_pow2(hashlife_t* const universe, const uint8_t step_log2) {
+	if (universe->num_nodes - universe->num_free_nodes > universe->gc_threshold)
+		collect_garbage(universe);
+	set_step(universe, step_log2);
+
+	// pad the root until nothing can escape the center it is advanced into
+	while (universe->nodes[universe->root].level < step_log2 + MIN_LEVEL ||
+	       !is_centered(universe, universe->root, 2))
+		if (!expand(universe))
+			return false;
+	const uint8_t level = universe->nodes[universe->root].level;
+	const uint32_t advanced = successor(universe, universe->root);
+	if (advanced == NIL)
+		return false;
+	universe->root = advanced;
+	universe->origin_x += (int64_t)1 << (level - 2);
+	universe->origin_y += (int64_t)1 << (level - 2);
+	return shrink(universe);
+}
+
+static void mark(hashlife_t* const universe, const uint32_t node) {
+	hashlife_node_t* const n = &universe->nodes[node];
+	if (n->is_marked || n->level == 0)
+		return;
+	n->is_marked = true;
+	mark(universe, n->nw);
+	mark(universe, n->ne);
+	mark(universe, n->sw);
+	mark(universe, n->se);
+}
+
+static void collect_garbage(hashlife_t* const universe) {
+	mark(universe, universe->root);
+	for (uint8_t level = 1; level <= HASHLIFE_MAX_LEVEL; level++)
+		if (universe->empty[level] != NIL)
+			mark(universe, universe->empty[level]);
+
+	// forget results that are about to be freed before unmarking anything
+	hashlife_node_t* const nodes = universe->nodes;
+	for (uint32_t i = LIVE_CELL + 1; i < universe->num_nodes; i++)
+		if (nodes[i].level != FREE_LEVEL && nodes[i].is_marked &&
+		    nodes[i].result != NIL && nodes[nodes[i].result].level && !nodes[nodes[i].result].is_marked)
+			nodes[i].result = NIL;
+
+	// rebuild the hash table from the reachable nodes, freeing the others
+	for (uint32_t i = 0; i <= universe->bucket_mask; i++)
+		universe->buckets[i] = NIL;
+	for (uint32_t i = LIVE_CELL + 1; i < universe->num_nodes; i++) {
+		hashlife_node_t* const node = &nodes[i];
+		if (node->level == FREE_LEVEL)
+			continue;
+		if (node->is_marked) {
+			const uint32_t slot = (uint32_t)(node->hash & universe->bucket_mask);
+			node->is_marked = false;
+			node->next = universe->buckets[slot];
+			universe->buckets[slot] = i;
+		}
+		else {
+			node->level = FREE_LEVEL;
+			node->next = universe->free_node;
+			universe->free_node = i;
+			universe->num_free_nodes++;
+		}
+	}
+
+	// give the reachable nodes room to grow if most of the store is reachable
+	if (universe->num_nodes - universe->num_free_nodes > universe->gc_threshold / 2 &&
+	    universe->gc_threshold <= NIL / 2)
+		universe->gc_threshold *= 2;
+}
+
+static uint32_t build(
+	hashlife_t* const universe,
+	const uint8_t level,
+	const uint64_t x,
+	const uint64_t y,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height
+) {
+	if (x >= width || y >= height)
+		return empty(universe, level);
+	if (!level)
+		return cells[stride * y + x] ? LIVE_CELL : DEAD_CELL;
+	const uint64_t half = (uint64_t)1 << (level - 1);
+	return join(
+		universe,
+		build(universe, level - 1, x, y, cells, stride, width, height),
+		build(universe, level - 1, x + half, y, cells, stride, width, height),
+		build(universe, level - 1, x, y + half, cells, stride, width, height),
+		build(universe, level - 1, x + half, y + half, cells, stride, width, height)
+	);
+}
+
+static void read_row(
+	const hashlife_t* const universe,
+	const uint32_t node,
+	const int64_t node_x,
+	const int64_t node_y,
+	const int64_t x,
+	const int64_t y,
+	const uint32_t width,
+	uint8_t* const cells
+) {
+	const hashlife_node_t* const n = &universe->nodes[node];
+	const int64_t size = (int64_t)1 << n->level;
+	if (!n->population || y < node_y || y >= node_y + size || node_x >= x + width || node_x + size <= x)
+		return;
+	if (!n->level) {
+		cells[node_x - x] = 1;
+		return;
+	}
+	const int64_t half = size / 2;
+	read_row(universe, n->nw, node_x, node_y, x, y, width, cells);
+	read_row(universe, n->ne, node_x + half, node_y, x, y, width, cells);
+	read_row(universe, n->sw, node_x, node_y + half, x, y, width, cells);
+	read_row(universe, n->se, node_x + half, node_y + half, x, y, width, cells);
+}
@@ -0,0 +1,709 @@
+/**
+ * @file kernel.c
+ * @brief Row stepping kernels for the byte-per-cell Game of Life grid.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <kernel.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNEL_X86
+#endif
+
+/**
+ * @brief The largest number of live neighbors of a cell.
+ */
+#define MAX_NEIGHBORS 8
+
+/**
+ * @brief Fill the table of the next state of every 3x3 neighborhood under the
+ *        rule of a kernel.
+ * @param[in,out] kernel The kernel whose table is filled.
+ */
+static void init_neighborhood_table(kernel_t* const kernel);
+
+/**
+ * @brief Compute the next generation of a row of a Generations rule one cell
+ *        at a time.
+ *
+ * The neighborhood of live cells is slid along the row and looked up as in
+ * the scalar kernel, deciding the birth of dead cells and the survival of
+ * live ones, whereas the other cells decay.
+ *
+ * @see kernel_row_t
+ */
+static bool kernel_row_scalar_generations(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+#ifdef KERNEL_X86
+
+/**
+ * @brief Compute the next generation of a row 16 cells at a time with SSE2,
+ *        under a rule known at compile time where the kind is constant.
+ * @param[in] kind The kind of the rule of the kernel, as a constant, such
+ *                 that only its branch of the rule is compiled.
+ * @see kernel_row_t
+ */
+static inline bool row_sse2(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width,
+	const rule_kind_t kind
+);
+
+/**
+ * @brief Compute the next generation of a row of Life 16 cells at a time with
+ *        SSE2.
+ * @see kernel_row_t
+ */
+static bool kernel_row_sse2_life(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of HighLife 16 cells at a time
+ *        with SSE2.
+ * @see kernel_row_t
+ */
+static bool kernel_row_sse2_highlife(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of Day & Night 16 cells at a
+ *        time with SSE2.
+ * @see kernel_row_t
+ */
+static bool kernel_row_sse2_day_and_night(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of any rule 16 cells at a time
+ *        with SSE2, comparing the neighbor counts against each count of the
+ *        rule.
+ * @see kernel_row_t
+ */
+static bool kernel_row_sse2_generic(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row 32 cells at a time with AVX2,
+ *        under a rule known at compile time where the kind is constant.
+ * @param[in] kind The kind of the rule of the kernel, as a constant, such
+ *                 that only its branch of the rule is compiled.
+ * @see kernel_row_t
+ */
+static inline bool row_avx2(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width,
+	const rule_kind_t kind
+);
+
+/**
+ * @brief Compute the next generation of a row of Life 32 cells at a time with
+ *        AVX2.
+ * @see kernel_row_t
+ */
+static bool kernel_row_avx2_life(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of HighLife 32 cells at a time
+ *        with AVX2.
+ * @see kernel_row_t
+ */
+static bool kernel_row_avx2_highlife(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of Day & Night 32 cells at a
+ *        time with AVX2.
+ * @see kernel_row_t
+ */
+static bool kernel_row_avx2_day_and_night(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of any rule 32 cells at a time
+ *        with AVX2, looking the neighbor counts up in the masks of the rule.
+ * @see kernel_row_t
+ */
+static bool kernel_row_avx2_generic(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of a Generations rule 16 cells
+ *        at a time with SSE2, comparing the live neighbor counts against each
+ *        count of the rule.
+ * @see kernel_row_t
+ */
+static bool kernel_row_sse2_generations(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+/**
+ * @brief Compute the next generation of a row of a Generations rule 32 cells
+ *        at a time with AVX2, looking the live neighbor counts up in the masks
+ *        of the rule.
+ * @see kernel_row_t
+ */
+static bool kernel_row_avx2_generations(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+);
+
+#endif // KERNEL_X86
+
+void kernel_select(kernel_t* const kernel, const rule_t rule) {
+	// Generations rules look up their live neighbors in the same table
+	kernel->rule = rule;
+	kernel->row = rule.num_states > 2 ? kernel_row_scalar_generations : kernel_row_scalar;
+	init_neighborhood_table(kernel);
+#ifdef KERNEL_X86
+	__builtin_cpu_init();
+	if (rule.num_states > 2) {
+		if (__builtin_cpu_supports("avx2"))
+			kernel->row = kernel_row_avx2_generations;
+		else if (__builtin_cpu_supports("sse2"))
+			kernel->row = kernel_row_sse2_generations;
+	} else if (__builtin_cpu_supports("avx2")) {
+		const kernel_row_t rows[] = {
+			[RULE_GENERIC] = kernel_row_avx2_generic,
+			[RULE_LIFE] = kernel_row_avx2_life,
+			[RULE_HIGHLIFE] = kernel_row_avx2_highlife,
+			[RULE_DAY_AND_NIGHT] = kernel_row_avx2_day_and_night,
+		};
+		kernel->row = rows[rule.kind];
+	} else if (__builtin_cpu_supports("sse2")) {
+		const kernel_row_t rows[] = {
+			[RULE_GENERIC] = kernel_row_sse2_generic,
+			[RULE_LIFE] = kernel_row_sse2_life,
+			[RULE_HIGHLIFE] = kernel_row_sse2_highlife,
+			[RULE_DAY_AND_NIGHT] = kernel_row_sse2_day_and_night,
+		};
+		kernel->row = rows[rule.kind];
+	}
+#endif
+}
+
+bool kernel_row_scalar(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	// slide the neighborhood along the row, loading one new column per cell
+	const uint8_t* const table = kernel->table;
+	uint32_t neighborhood =
+		((uint32_t)above[-1] | (uint32_t)cells[-1] << 1 | (uint32_t)below[-1] << 2) << 3 |
+		((uint32_t)above[0] | (uint32_t)cells[0] << 1 | (uint32_t)below[0] << 2) << 6;
+	uint8_t changed = 0;
+	for (uint32_t col = 0; col < width; col++) {
+		const uint32_t east = (uint32_t)above[col + 1] | (uint32_t)cells[col + 1] << 1 | (uint32_t)below[col + 1] << 2;
+		neighborhood = neighborhood >> 3 | east << 6;
+		const uint8_t new_cell = table[neighborhood];
+		changed |= cells[col] ^ new_cell;
+		new_cells[col] = new_cell;
+	}
+	return changed != 0;
+}
+
+static bool kernel_row_scalar_generations(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	// slide the neighborhood of live cells along the row, as for two states
+	const uint8_t* const table = kernel->table;
+	const uint8_t last_state = (uint8_t)(kernel->rule.num_states - 1);
+	uint32_t neighborhood =
+		((uint32_t)(above[-1] == 1) | (uint32_t)(cells[-1] == 1) << 1 | (uint32_t)(below[-1] == 1) << 2) << 3 |
+		((uint32_t)(above[0] == 1) | (uint32_t)(cells[0] == 1) << 1 | (uint32_t)(below[0] == 1) << 2) << 6;
+	uint8_t changed = 0;
+	for (uint32_t col = 0; col < width; col++) {
+		const uint32_t east =
+			(uint32_t)(above[col + 1] == 1) | (uint32_t)(cells[col + 1] == 1) << 1 | (uint32_t)(below[col + 1] == 1) << 2;
+		neighborhood = neighborhood >> 3 | east << 6;
+
+		// dead cells are born and live cells survive as the table says, and
+		// every other cell decays one state, the last one back to dead
+		const uint8_t cell = cells[col];
+		uint8_t new_cell;
+		if (cell <= 1 && table[neighborhood])
+			new_cell = 1;
+		else
+			new_cell = cell && cell != last_state ? cell + 1 : 0;
+		changed |= cell ^ new_cell;
+		new_cells[col] = new_cell;
+	}
+	return changed != 0;
+}
+
+static void init_neighborhood_table(kernel_t* const kernel) {
+	for (uint32_t neighborhood = 0; neighborhood < KERNEL_NUM_NEIGHBORHOODS; neighborhood++) {
+		const uint8_t cell = (neighborhood >> 4) & 1;
+		const uint8_t num_live_neighbors = (uint8_t)(__builtin_popcount(neighborhood) - cell);
+		kernel->table[neighborhood] = rule_apply(&kernel->rule, cell, num_live_neighbors);
+	}
+}
+
+#ifdef KERNEL_X86
+
+__attribute__((always_inline, target("sse2")))
+static inline bool row_sse2(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width,
+	const rule_kind_t kind
+) {
+	const uint16_t birth = kernel->rule.birth;
+	const uint16_t survival = kernel->rule.survival;
+	const __m128i one = _mm_set1_epi8(1);
+	__m128i changed = _mm_setzero_si128();
+	uint32_t col = 0;
+	for (; col + sizeof(__m128i) <= width; col += sizeof(__m128i)) {
+		// sum the three-row neighborhood; cells are 0 or 1, so bytes never overflow
+		const __m128i cell = _mm_loadu_si128((const __m128i*)(cells + col));
+		__m128i sum = _mm_add_epi8(
+			_mm_loadu_si128((const __m128i*)(cells + col - 1)),
+			_mm_loadu_si128((const __m128i*)(cells + col + 1))
+		);
+		sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i*)(above + col - 1)));
+		sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i*)(above + col)));
+		sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i*)(above + col + 1)));
+		sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i*)(below + col - 1)));
+		sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i*)(below + col)));
+		sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i*)(below + col + 1)));
+		const __m128i is_live = _mm_cmpeq_epi8(cell, one);
+
+		__m128i lives;
+		switch (kind) {
+			case RULE_LIFE:
+				// live with three neighbors, or two if already live
+				lives = _mm_or_si128(
+					_mm_cmpeq_epi8(sum, _mm_set1_epi8(3)),
+					_mm_and_si128(_mm_cmpeq_epi8(sum, _mm_set1_epi8(2)), is_live)
+				);
+				break;
+			case RULE_HIGHLIFE:
+				// Life, and also born with six neighbors
+				lives = _mm_or_si128(
+					_mm_cmpeq_epi8(sum, _mm_set1_epi8(3)),
+					_mm_or_si128(
+						_mm_and_si128(_mm_cmpeq_epi8(sum, _mm_set1_epi8(2)), is_live),
+						_mm_andnot_si128(is_live, _mm_cmpeq_epi8(sum, _mm_set1_epi8(6)))
+					)
+				);
+				break;
+			case RULE_DAY_AND_NIGHT:
+				// live with three or at least six neighbors, or four if already live
+				lives = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(sum, _mm_set1_epi8(3)), _mm_cmpgt_epi8(sum, _mm_set1_epi8(5))),
+					_mm_and_si128(_mm_cmpeq_epi8(sum, _mm_set1_epi8(4)), is_live)
+				);
+				break;
+			default: {
+				// compare against only the counts the rule names
+				__m128i born = _mm_setzero_si128();
+				__m128i survives = _mm_setzero_si128();
+				for (uint8_t n = 0; n <= MAX_NEIGHBORS; n++) {
+					if (!(((birth | survival) >> n) & 1))
+						continue;
+					const __m128i is_count = _mm_cmpeq_epi8(sum, _mm_set1_epi8((char)n));
+					if ((birth >> n) & 1)
+						born = _mm_or_si128(born, is_count);
+					if ((survival >> n) & 1)
+						survives = _mm_or_si128(survives, is_count);
+				}
+				lives = _mm_or_si128(_mm_andnot_si128(is_live, born), _mm_and_si128(is_live, survives));
+			}
+		}
+		const __m128i new_cell = _mm_and_si128(lives, one);
+		_mm_storeu_si128((__m128i*)(new_cells + col), new_cell);
+		changed = _mm_or_si128(changed, _mm_xor_si128(cell, new_cell));
+	}
+	const bool tail_changed = kernel_row_scalar(kernel, above + col, cells + col, below + col, new_cells + col, width - col);
+	return tail_changed || _mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF;
+}
+
+__attribute__((target("sse2")))
+static bool kernel_row_sse2_life(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_sse2(kernel, above, cells, below, new_cells, width, RULE_LIFE);
+}
+
+__attribute__((target("sse2")))
+static bool kernel_row_sse2_highlife(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_sse2(kernel, above, cells, below, new_cells, width, RULE_HIGHLIFE);
+}
+
+__attribute__((target("sse2")))
+static bool kernel_row_sse2_day_and_night(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_sse2(kernel, above, cells, below, new_cells, width, RULE_DAY_AND_NIGHT);
+}
+
+__attribute__((target("sse2")))
+static bool kernel_row_sse2_generic(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_sse2(kernel, above, cells, below, new_cells, width, RULE_GENERIC);
+}
+
+__attribute__((always_inline, target("avx2")))
+static inline bool row_avx2(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width,
+	const rule_kind_t kind
+) {
+	// the masks of the rule as byte tables indexed by neighbor count, in both
+	// lanes as shuffles look up within each lane
+	uint8_t birth_bytes[sizeof(__m256i)];
+	uint8_t survival_bytes[sizeof(__m256i)];
+	for (uint8_t i = 0; i < sizeof(__m256i); i++) {
+		const uint8_t n = i % sizeof(__m128i);
+		birth_bytes[i] = n <= MAX_NEIGHBORS ? (kernel->rule.birth >> n) & 1 : 0;
+		survival_bytes[i] = n <= MAX_NEIGHBORS ? (kernel->rule.survival >> n) & 1 : 0;
+	}
+	const __m256i birth = _mm256_loadu_si256((const __m256i*)birth_bytes);
+	const __m256i survival = _mm256_loadu_si256((const __m256i*)survival_bytes);
+
+	const __m256i one = _mm256_set1_epi8(1);
+	__m256i changed = _mm256_setzero_si256();
+	uint32_t col = 0;
+	for (; col + sizeof(__m256i) <= width; col += sizeof(__m256i)) {
+		// sum the three-row neighborhood; cells are 0 or 1, so bytes never overflow
+		const __m256i cell = _mm256_loadu_si256((const __m256i*)(cells + col));
+		__m256i sum = _mm256_add_epi8(
+			_mm256_loadu_si256((const __m256i*)(cells + col - 1)),
+			_mm256_loadu_si256((const __m256i*)(cells + col + 1))
+		);
+		sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i*)(above + col - 1)));
+		sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i*)(above + col)));
+		sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i*)(above + col + 1)));
+		sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i*)(below + col - 1)));
+		sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i*)(below + col)));
+		sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i*)(below + col + 1)));
+		const __m256i is_live = _mm256_cmpeq_epi8(cell, one);
+
+		__m256i new_cell;
+		switch (kind) {
+			case RULE_LIFE:
+				// live with three neighbors, or two if already live
+				new_cell = _mm256_and_si256(_mm256_or_si256(
+					_mm256_cmpeq_epi8(sum, _mm256_set1_epi8(3)),
+					_mm256_and_si256(_mm256_cmpeq_epi8(sum, _mm256_set1_epi8(2)), is_live)
+				), one);
+				break;
+			case RULE_HIGHLIFE:
+				// Life, and also born with six neighbors
+				new_cell = _mm256_and_si256(_mm256_or_si256(
+					_mm256_cmpeq_epi8(sum, _mm256_set1_epi8(3)),
+					_mm256_or_si256(
+						_mm256_and_si256(_mm256_cmpeq_epi8(sum, _mm256_set1_epi8(2)), is_live),
+						_mm256_andnot_si256(is_live, _mm256_cmpeq_epi8(sum, _mm256_set1_epi8(6)))
+					)
+				), one);
+				break;
+			case RULE_DAY_AND_NIGHT:
+				// live with three or at least six neighbors, or four if already live
+				new_cell = _mm256_and_si256(_mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(sum, _mm256_set1_epi8(3)), _mm256_cmpgt_epi8(sum, _mm256_set1_epi8(5))),
+					_mm256_and_si256(_mm256_cmpeq_epi8(sum, _mm256_set1_epi8(4)), is_live)
+				), one);
+				break;
+			default:
+				// look the counts up in the masks, picking survival for live cells
+				new_cell = _mm256_blendv_epi8(
+					_mm256_shuffle_epi8(birth, sum),
+					_mm256_shuffle_epi8(survival, sum),
+					is_live
+				);
+		}
+		_mm256_storeu_si256((__m256i*)(new_cells + col), new_cell);
+		changed = _mm256_or_si256(changed, _mm256_xor_si256(cell, new_cell));
+	}
+	const bool tail_changed = kernel_row_scalar(kernel, above + col, cells + col, below + col, new_cells + col, width - col);
+	return tail_changed || !_mm256_testz_si256(changed, changed);
+}
+
+__attribute__((target("avx2")))
+static bool kernel_row_avx2_life(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_avx2(kernel, above, cells, below, new_cells, width, RULE_LIFE);
+}
+
+__attribute__((target("avx2")))
+static bool kernel_row_avx2_highlife(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_avx2(kernel, above, cells, below, new_cells, width, RULE_HIGHLIFE);
+}
+
+__attribute__((target("avx2")))
+static bool kernel_row_avx2_day_and_night(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_avx2(kernel, above, cells, below, new_cells, width, RULE_DAY_AND_NIGHT);
+}
+
+__attribute__((target("avx2")))
+static bool kernel_row_avx2_generic(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	return row_avx2(kernel, above, cells, below, new_cells, width, RULE_GENERIC);
+}
+
+__attribute__((target("sse2")))
+static bool kernel_row_sse2_generations(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	const uint16_t birth = kernel->rule.birth;
+	const uint16_t survival = kernel->rule.survival;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi8(1);
+	const __m128i last_state = _mm_set1_epi8((char)(kernel->rule.num_states - 1));
+	__m128i changed = _mm_setzero_si128();
+	uint32_t col = 0;
+	for (; col + sizeof(__m128i) <= width; col += sizeof(__m128i)) {
+		// each live neighbor compares to -1, so the negated sum counts them
+		const __m128i cell = _mm_loadu_si128((const __m128i*)(cells + col));
+		__m128i sum = _mm_add_epi8(
+			_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(cells + col - 1)), one),
+			_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(cells + col + 1)), one)
+		);
+		sum = _mm_add_epi8(sum, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(above + col - 1)), one));
+		sum = _mm_add_epi8(sum, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(above + col)), one));
+		sum = _mm_add_epi8(sum, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(above + col + 1)), one));
+		sum = _mm_add_epi8(sum, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(below + col - 1)), one));
+		sum = _mm_add_epi8(sum, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(below + col)), one));
+		sum = _mm_add_epi8(sum, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(below + col + 1)), one));
+		sum = _mm_sub_epi8(zero, sum);
+		const __m128i is_dead = _mm_cmpeq_epi8(cell, zero);
+		const __m128i is_live = _mm_cmpeq_epi8(cell, one);
+
+		// compare against only the counts the rule names
+		__m128i born = _mm_setzero_si128();
+		__m128i survives = _mm_setzero_si128();
+		for (uint8_t n = 0; n <= MAX_NEIGHBORS; n++) {
+			if (!(((birth | survival) >> n) & 1))
+				continue;
+			const __m128i is_count = _mm_cmpeq_epi8(sum, _mm_set1_epi8((char)n));
+			if ((birth >> n) & 1)
+				born = _mm_or_si128(born, is_count);
+			if ((survival >> n) & 1)
+				survives = _mm_or_si128(survives, is_count);
+		}
+		const __m128i lives = _mm_or_si128(_mm_and_si128(is_dead, born), _mm_and_si128(is_live, survives));
+
+		// every other cell decays one state, the last one back to dead
+		const __m128i decayed = _mm_andnot_si128(
+			_mm_or_si128(is_dead, _mm_cmpeq_epi8(cell, last_state)),
+			_mm_add_epi8(cell, one)
+		);
+		const __m128i new_cell = _mm_or_si128(_mm_and_si128(lives, one), _mm_andnot_si128(lives, decayed));
+		_mm_storeu_si128((__m128i*)(new_cells + col), new_cell);
+		changed = _mm_or_si128(changed, _mm_xor_si128(cell, new_cell));
+	}
+	const bool tail_changed =
+		kernel_row_scalar_generations(kernel, above + col, cells + col, below + col, new_cells + col, width - col);
+	return tail_changed || _mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF;
+}
+
+__attribute__((target("avx2")))
+static bool kernel_row_avx2_generations(
+	const kernel_t* const kernel,
+	const uint8_t* const above,
+	const uint8_t* const cells,
+	const uint8_t* const below,
+	uint8_t* const new_cells,
+	const uint32_t width
+) {
+	// the masks of the rule as byte tables indexed by neighbor count, in both
+	// lanes as shuffles look up within each lane
+	uint8_t birth_bytes[sizeof(__m256i)];
+	uint8_t survival_bytes[sizeof(__m256i)];
+	for (uint8_t i = 0; i < sizeof(__m256i); i++) {
+		const uint8_t n = i % sizeof(__m128i);
+		birth_bytes[i] = n <= MAX_NEIGHBORS && (kernel->rule.birth >> n) & 1 ? UINT8_MAX : 0;
+		survival_bytes[i] = n <= MAX_NEIGHBORS && (kernel->rule.survival >> n) & 1 ? UINT8_MAX : 0;
+	}
+	const __m256i birth = _mm256_loadu_si256((const __m256i*)birth_bytes);
+	const __m256i survival = _mm256_loadu_si256((const __m256i*)survival_bytes);
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi8(1);
+	const __m256i last_state = _mm256_set1_epi8((char)(kernel->rule.num_states - 1));
+	__m256i changed = _mm256_setzero_si256();
+	uint32_t col = 0;
+	for (; col + sizeof(__m256i) <= width; col += sizeof(__m256i)) {
+		// each live neighbor compares to -1, so the negated sum counts them
+		const __m256i cell = _mm256_loadu_si256((const __m256i*)(cells + col));
+		__m256i sum = _mm256_add_epi8(
+			_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(cells + col - 1)), one),
+			_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(cells + col + 1)), one)
+		);
+		sum = _mm256_add_epi8(sum, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(above + col - 1)), one));
+		sum = _mm256_add_epi8(sum, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(above + col)), one));
+		sum = _mm256_add_epi8(sum, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(above + col + 1)), one));
+		sum = _mm256_add_epi8(sum, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(below + col - 1)), one));
+		sum = _mm256_add_epi8(sum, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(below + col)), one));
+		sum = _mm256_add_epi8(sum, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(below + col + 1)), one));
+		sum = _mm256_sub_epi8(zero, sum);
+		const __m256i is_dead = _mm256_cmpeq_epi8(cell, zero);
+		const __m256i is_live = _mm256_cmpeq_epi8(cell, one);
+
+		// look the counts up in the masks, birth for dead cells and survival
+		// for live ones
+		const __m256i lives = _mm256_or_si256(
+			_mm256_and_si256(is_dead, _mm256_shuffle_epi8(birth, sum)),
+			_mm256_and_si256(is_live, _mm256_shuffle_epi8(survival, sum))
+		);
+
+		// every other cell decays one state, the last one back to dead
+		const __m256i decayed = _mm256_andnot_si256(
+			_mm256_or_si256(is_dead, _mm256_cmpeq_epi8(cell, last_state)),
+			_mm256_add_epi8(cell, one)
+		);
+		const __m256i new_cell = _mm256_blendv_epi8(decayed, one, lives);
+		_mm256_storeu_si256((__m256i*)(new_cells + col), new_cell);
+		changed = _mm256_or_si256(changed, _mm256_xor_si256(cell, new_cell));
+	}
+	const bool tail_changed =
+		kernel_row_scalar_generations(kernel, above + col, cells + col, below + col, new_cells + col, width - col);
+	return tail_changed || !_mm256_testz_si256(changed, changed);
+}
+
+#endif // KERNEL_X86
@@ -6,7 +6,10 @@
  */
 
 #include <parsing.h>
+#include <errno.h>
+#include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 bool skip_prefix(char** string, const char* const prefix) {
@@ -41,6 +44,34 @@ bool parse_uint16(const char* const arg, uint16_t* value) {
 	return true;
 }
 
+bool parse_uint32(const char* const arg, uint32_t* value) {
+	if (!arg || !value)
+		return false;
+	int64_t temp_value;
+	if (!sscanf(arg, "%ld", &temp_value))
+		return false;
+	if (temp_value < 0 || temp_value > UINT32_MAX)
+		return false;
+	*value = (uint32_t)temp_value;
+	return true;
+}
+
+bool parse_uint64(const char* const arg, uint64_t* value) {
+	if (!arg || !value)
+		return false;
+	if (strchr(arg, '-'))
+		return false;
+
+	// out-of-range values are clamped rather than rejected by sscanf
+	char* end;
+	errno = 0;
+	const unsigned long long temp_value = strtoull(arg, &end, 10);
+	if (end == arg || errno == ERANGE)
+		return false;
+	*value = (uint64_t)temp_value;
+	return true;
+}
+
 bool parse_char(const char* const arg, char* character) {
 	if (!arg || !character)
 		return false;
@@ -0,0 +1,562 @@
+/**
+ * @file plane.c
+ * @brief Unbounded Game of Life plane stored as a hash map of bit-packed
+ *        chunks.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <plane.h>
+#include <bitboard.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Index denoting the absence of a chunk.
+ */
+static const uint32_t NIL = UINT32_MAX;
+
+/**
+ * @brief The number of chunks and buckets allocated up front.
+ */
+static const uint32_t INITIAL_CAPACITY = 64;
+
+/**
+ * @brief Multiplier spreading each word across the hash.
+ */
+static const uint64_t HASH_PRIME_1 = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Multiplier mixing the hash after each word.
+ */
+static const uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+/**
+ * @brief Fold a word into a hash.
+ * @param[in] hash The hash to fold into.
+ * @param[in] word The word to fold.
+ * @return The updated hash.
+ */
+static uint64_t mix(const uint64_t hash, const uint64_t word);
+
+/**
+ * @brief Retrieve the coordinate of the chunk holding a cell.
+ * @param[in] coord The coordinate of the cell.
+ * @return The coordinate of the chunk, rounded towards negative infinity.
+ */
+static int64_t chunk_coord(const int64_t coord);
+
+/**
+ * @brief Retrieve the bucket of the hash table chaining a chunk.
+ * @param[in] plane The plane holding the hash table.
+ * @param[in] x The column of the chunk.
+ * @param[in] y The row of the chunk.
+ * @return The index of the bucket.
+ */
+static uint32_t chunk_bucket(const plane_t* const plane, const int64_t x, const int64_t y);
+
+/**
+ * @brief Find a chunk by its coordinates.
+ * @param[in] plane The plane to search.
+ * @param[in] x The column of the chunk.
+ * @param[in] y The row of the chunk.
+ * @return The index of the chunk, or NIL if it is not stored.
+ */
+static uint32_t find_chunk(const plane_t* const plane, const int64_t x, const int64_t y);
+
+/**
+ * @brief Find a chunk by its coordinates, allocating it empty if it is not
+ *        stored.
+ *
+ * Allocating a chunk may move every chunk of the store.
+ *
+ * @param[in,out] plane The plane to search.
+ * @param[in] x The column of the chunk.
+ * @param[in] y The row of the chunk.
+ * @return The index of the chunk, or NIL if it could not be allocated.
+ */
+static uint32_t insert_chunk(plane_t* const plane, const int64_t x, const int64_t y);
+
+/**
+ * @brief Unlink a chunk from the hash table and free it.
+ * @param[in,out] plane The plane storing the chunk.
+ * @param[in] chunk The index of the chunk.
+ */
+static void remove_chunk(plane_t* const plane, const uint32_t chunk);
+
+/**
+ * @brief Double the number of buckets of the hash table, rechaining every
+ *        chunk.
+ *
+ * The table is left as is if the allocation fails.
+ *
+ * @param[in,out] plane The plane holding the hash table.
+ */
+static void grow_buckets(plane_t* const plane);
+
+/**
+ * @brief Hash the current generation of a chunk along with its position.
+ * @param[in] plane The plane storing the chunk.
+ * @param[in] chunk The chunk to hash.
+ * @return The hash of the chunk, or zero if it is empty.
+ */
+static uint64_t hash_chunk(const plane_t* const plane, const plane_chunk_t* const chunk);
+
+/**
+ * @brief Allocate the chunks bordering the live cells at the edges of every
+ *        chunk, into which those cells may grow in the next generation, and
+ *        flag them to be computed.
+ * @param[in,out] plane The plane to expand.
+ * @return True if the chunks were allocated, false otherwise.
+ */
+static bool expand(plane_t* const plane);
+
+/**
+ * @brief Flag the chunks that changed in the previous generation, along with
+ *        their neighbors, as the chunks to compute.
+ * @param[in,out] plane The plane to flag.
+ */
+static void activate(plane_t* const plane);
+
+/**
+ * @brief Check whether any neighbor of a chunk holds live cells.
+ * @param[in] plane The plane storing the chunk.
+ * @param[in] chunk The index of the chunk.
+ * @return True if a neighboring chunk is not empty, false otherwise.
+ */
+static bool is_near_live(const plane_t* const plane, const uint32_t chunk);
+
+/**
+ * @brief Retrieve a row of the neighborhood of a chunk, along with the row
+ *        shifted such that bits hold west and east cells.
+ * @param[in] plane The plane storing the chunks.
+ * @param[in] neighbors The chunks surrounding and including the chunk, or NIL
+ *                      for those not stored, row by row.
+ * @param[in] row The row relative to the chunk, from -1 to 64.
+ * @param[out] west The row shifted such that bits hold west cells.
+ * @param[out] cells The row.
+ * @param[out] east The row shifted such that bits hold east cells.
+ */
+static void get_neighborhood_row(
+	const plane_t* const plane,
+	const uint32_t* const neighbors,
+	const int32_t row,
+	uint64_t* const west,
+	uint64_t* const cells,
+	uint64_t* const east
+);
+
+/**
+ * @brief Compute the next generation of a chunk.
+ * @param[in,out] plane The plane storing the chunk.
+ * @param[in] chunk The index of the chunk.
+ * @return True if the next generation of the chunk differs from the current
+ *         one.
+ */
+static bool compute_chunk(plane_t* const plane, const uint32_t chunk);
+
+bool plane_init(
+	plane_t* const plane,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height,
+	const rule_t rule
+) {
+	plane->rule = rule;
+	plane->num_chunks = 0;
+	plane->num_used_chunks = 0;
+	plane->capacity = INITIAL_CAPACITY;
+	plane->free_chunk = NIL;
+	plane->bucket_mask = INITIAL_CAPACITY - 1;
+	plane->hash = 0;
+	plane->current = 0;
+	plane->chunks = (plane_chunk_t*)malloc(INITIAL_CAPACITY * sizeof(plane_chunk_t));
+	plane->buckets = (uint32_t*)malloc(INITIAL_CAPACITY * sizeof(uint32_t));
+	if (!plane->chunks || !plane->buckets) {
+		plane_destroy(plane);
+		return false;
+	}
+	for (uint32_t i = 0; i < INITIAL_CAPACITY; i++)
+		plane->buckets[i] = NIL;
+
+	for (uint32_t y = 0; y < height; y++)
+		for (uint32_t x = 0; x < width; x++) {
+			if (!cells[stride * y + x])
+				continue;
+			const uint32_t chunk = insert_chunk(plane, x / PLANE_CHUNK_SIZE, y / PLANE_CHUNK_SIZE);
+			if (chunk == NIL) {
+				plane_destroy(plane);
+				return false;
+			}
+			plane->chunks[chunk].rows[0][y % PLANE_CHUNK_SIZE] |= (uint64_t)1 << (x % PLANE_CHUNK_SIZE);
+		}
+	// every chunk is computed in the first generation
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		plane->chunks[i].hash = hash_chunk(plane, &plane->chunks[i]);
+		plane->chunks[i].is_changed = true;
+		plane->hash += plane->chunks[i].hash;
+	}
+	return true;
+}
+
+void plane_destroy(plane_t* const plane) {
+	free(plane->chunks);
+	free(plane->buckets);
+	plane->chunks = NULL;
+	plane->buckets = NULL;
+}
+
+bool plane_step(plane_t* const plane, bool* const changed) {
+	activate(plane);
+	if (!expand(plane))
+		return false;
+
+	*changed = false;
+	const uint8_t next = plane->current ^ 1;
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		plane_chunk_t* const chunk = &plane->chunks[i];
+		if (!chunk->is_used)
+			continue;
+		if (!chunk->is_active) {
+			// an inactive chunk stays as it was
+			memcpy(chunk->rows[next], chunk->rows[plane->current], sizeof(chunk->rows[next]));
+			chunk->is_changed = false;
+			continue;
+		}
+		chunk->is_changed = compute_chunk(plane, i);
+		if (chunk->is_changed)
+			*changed = true;
+	}
+	plane->current = next;
+
+	// rehash the chunks that changed
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		plane_chunk_t* const chunk = &plane->chunks[i];
+		if (!chunk->is_used || !chunk->is_changed)
+			continue;
+		const uint64_t hash = hash_chunk(plane, chunk);
+		plane->hash += hash - chunk->hash;
+		chunk->hash = hash;
+	}
+
+	// free the chunks that stayed empty, unless live cells could grow into
+	// them again
+	for (uint32_t i = 0; i < plane->num_chunks; i++)
+		if (plane->chunks[i].is_used && !plane->chunks[i].is_changed && !plane->chunks[i].hash &&
+		    !is_near_live(plane, i))
+			remove_chunk(plane, i);
+	return true;
+}
+
+void plane_get_row(
+	const plane_t* const plane,
+	const int64_t x,
+	const int64_t y,
+	const uint32_t width,
+	uint8_t* const cells
+) {
+	const int64_t chunk_y = chunk_coord(y);
+	const uint32_t row = (uint32_t)(y - chunk_y * PLANE_CHUNK_SIZE);
+	uint32_t col = 0;
+	while (col < width) {
+		const int64_t chunk_x = chunk_coord(x + col);
+		const uint32_t offset = (uint32_t)(x + col - chunk_x * PLANE_CHUNK_SIZE);
+		const uint32_t span = PLANE_CHUNK_SIZE - offset < width - col ? PLANE_CHUNK_SIZE - offset : width - col;
+		const uint32_t chunk = find_chunk(plane, chunk_x, chunk_y);
+		const uint64_t word = chunk == NIL ? 0 : plane->chunks[chunk].rows[plane->current][row];
+		for (uint32_t bit = 0; bit < span; bit++)
+			cells[col + bit] = (uint8_t)((word >> (offset + bit)) & 1);
+		col += span;
+	}
+}
+
+bool plane_bounds(
+	const plane_t* const plane,
+	int64_t* const x_min,
+	int64_t* const y_min,
+	int64_t* const x_max,
+	int64_t* const y_max
+) {
+	bool is_found = false;
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		const plane_chunk_t* const chunk = &plane->chunks[i];
+		if (!chunk->is_used || !chunk->hash)
+			continue;
+		const uint64_t* const rows = chunk->rows[plane->current];
+		uint64_t columns = 0;
+		int64_t first_row = PLANE_CHUNK_SIZE;
+		int64_t last_row = 0;
+		for (int64_t row = 0; row < PLANE_CHUNK_SIZE; row++) {
+			if (!rows[row])
+				continue;
+			columns |= rows[row];
+			if (row < first_row)
+				first_row = row;
+			last_row = row;
+		}
+		const int64_t left = chunk->x * PLANE_CHUNK_SIZE + __builtin_ctzll(columns);
+		const int64_t right = chunk->x * PLANE_CHUNK_SIZE + PLANE_CHUNK_SIZE - 1 - __builtin_clzll(columns);
+		const int64_t top = chunk->y * PLANE_CHUNK_SIZE + first_row;
+		const int64_t bottom = chunk->y * PLANE_CHUNK_SIZE + last_row;
+		if (!is_found || left < *x_min)
+			*x_min = left;
+		if (!is_found || right > *x_max)
+			*x_max = right;
+		if (!is_found || top < *y_min)
+			*y_min = top;
+		if (!is_found || bottom > *y_max)
+			*y_max = bottom;
+		is_found = true;
+	}
+	return is_found;
+}
+
+size_t plane_list_cells(
+	const plane_t* const plane,
+	int64_t* const xs,
+	int64_t* const ys,
+	const size_t capacity
+) {
+	const size_t num_cells = (size_t)plane_population(plane);
+	if (num_cells > capacity)
+		return num_cells;
+	size_t i = 0;
+	for (uint32_t c = 0; c < plane->num_chunks; c++) {
+		const plane_chunk_t* const chunk = &plane->chunks[c];
+		if (!chunk->is_used || !chunk->hash)
+			continue;
+		const uint64_t* const rows = chunk->rows[plane->current];
+		for (int64_t row = 0; row < PLANE_CHUNK_SIZE; row++)
+			for (uint64_t bits = rows[row]; bits; bits &= bits - 1) {
+				xs[i] = chunk->x * PLANE_CHUNK_SIZE + __builtin_ctzll(bits);
+				ys[i] = chunk->y * PLANE_CHUNK_SIZE + row;
+				i++;
+			}
+	}
+	return num_cells;
+}
+
+uint64_t plane_population(const plane_t* const plane) {
+	uint64_t population = 0;
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		if (!plane->chunks[i].is_used)
+			continue;
+		for (uint32_t row = 0; row < PLANE_CHUNK_SIZE; row++)
+			population += (uint64_t)__builtin_popcountll(plane->chunks[i].rows[plane->current][row]);
+	}
+	return population;
+}
+
+uint64_t plane_hash(const plane_t* const plane) {
+	return plane->hash;
+}
+
+static uint64_t mix(const uint64_t hash, const uint64_t word) {
+	const uint64_t mixed = hash ^ (word * HASH_PRIME_1);
+	return ((mixed << 31) | (mixed >> 33)) * HASH_PRIME_2;
+}
+
+static int64_t chunk_coord(const int64_t coord) {
+	return coord >= 0 ? coord / PLANE_CHUNK_SIZE : -((-(coord + 1)) / PLANE_CHUNK_SIZE) - 1;
+}
+
+static uint32_t chunk_bucket(const plane_t* const plane, const int64_t x, const int64_t y) {
+	return (uint32_t)(mix(mix(0, (uint64_t)x), (uint64_t)y) & plane->bucket_mask);
+}
+
+static uint32_t find_chunk(const plane_t* const plane, const int64_t x, const int64_t y) {
+	uint32_t chunk = plane->buckets[chunk_bucket(plane, x, y)];
+	while (chunk != NIL && (plane->chunks[chunk].x != x || plane->chunks[chunk].y != y))
+		chunk = plane->chunks[chunk].next;
+	return chunk;
+}
+
+static uint32_t insert_chunk(plane_t* const plane, const int64_t x, const int64_t y) {
+	const uint32_t found = find_chunk(plane, x, y);
+	if (found != NIL)
+		return found;
+
+	uint32_t chunk = plane->free_chunk;
+	if (chunk != NIL)
+		plane->free_chunk = plane->chunks[chunk].next;
+	else {
+		if (plane->num_chunks == plane->capacity) {
+			if (plane->capacity > (NIL - 1) / 2)
+				return NIL;
+			const uint32_t capacity = plane->capacity * 2;
+			plane_chunk_t* const chunks = (plane_chunk_t*)realloc(plane->chunks, capacity * sizeof(plane_chunk_t));
+			if (!chunks)
+				return NIL;
+			plane->chunks = chunks;
+			plane->capacity = capacity;
+		}
+		chunk = plane->num_chunks++;
+	}
+
+	// a new chunk is empty, as was the plane where it lies, so only the chunk
+	// itself needs to be computed
+	plane_chunk_t* const new_chunk = &plane->chunks[chunk];
+	memset(new_chunk->rows, 0, sizeof(new_chunk->rows));
+	new_chunk->x = x;
+	new_chunk->y = y;
+	new_chunk->hash = 0;
+	new_chunk->is_used = true;
+	new_chunk->is_changed = false;
+	new_chunk->is_active = true;
+	const uint32_t bucket = chunk_bucket(plane, x, y);
+	new_chunk->next = plane->buckets[bucket];
+	plane->buckets[bucket] = chunk;
+	if (++plane->num_used_chunks > plane->bucket_mask)
+		grow_buckets(plane);
+	return chunk;
+}
+
+static void remove_chunk(plane_t* const plane, const uint32_t chunk) {
+	plane_chunk_t* const removed = &plane->chunks[chunk];
+	uint32_t* link = &plane->buckets[chunk_bucket(plane, removed->x, removed->y)];
+	while (*link != chunk)
+		link = &plane->chunks[*link].next;
+	*link = removed->next;
+	removed->is_used = false;
+	removed->next = plane->free_chunk;
+	plane->free_chunk = chunk;
+	plane->num_used_chunks--;
+}
+
+static void grow_buckets(plane_t* const plane) {
+	if (plane->bucket_mask >= (NIL >> 1))
+		return;
+	const uint32_t num_buckets = (plane->bucket_mask + 1) * 2;
+	uint32_t* const buckets = (uint32_t*)malloc(num_buckets * sizeof(uint32_t));
+	if (!buckets)
+		return;
+	for (uint32_t i = 0; i < num_buckets; i++)
+		buckets[i] = NIL;
+	free(plane->buckets);
+	plane->buckets = buckets;
+	plane->bucket_mask = num_buckets - 1;
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		plane_chunk_t* const chunk = &plane->chunks[i];
+		if (!chunk->is_used)
+			continue;
+		const uint32_t bucket = chunk_bucket(plane, chunk->x, chunk->y);
+		chunk->next = buckets[bucket];
+		buckets[bucket] = i;
+	}
+}
+
+static uint64_t hash_chunk(const plane_t* const plane, const plane_chunk_t* const chunk) {
+	const uint64_t* const rows = chunk->rows[plane->current];
+	bool is_empty = true;
+	uint64_t hash = mix(mix(0, (uint64_t)chunk->x), (uint64_t)chunk->y);
+	for (uint32_t row = 0; row < PLANE_CHUNK_SIZE; row++) {
+		if (rows[row])
+			is_empty = false;
+		hash = mix(hash, rows[row]);
+	}
+	return is_empty ? 0 : hash;
+}
+
+static bool expand(plane_t* const plane) {
+	// chunks allocated along the way are empty, so need not be expanded
+	const uint32_t num_chunks = plane->num_chunks;
+	for (uint32_t i = 0; i < num_chunks; i++) {
+		const plane_chunk_t* const chunk = &plane->chunks[i];
+		if (!chunk->is_used || !chunk->hash)
+			continue;
+		const uint64_t* const rows = chunk->rows[plane->current];
+		uint64_t columns = 0;
+		for (uint32_t row = 0; row < PLANE_CHUNK_SIZE; row++)
+			columns |= rows[row];
+		const uint64_t top = rows[0];
+		const uint64_t bottom = rows[PLANE_CHUNK_SIZE - 1];
+		const uint64_t west_bit = 1;
+		const uint64_t east_bit = (uint64_t)1 << (PLANE_CHUNK_SIZE - 1);
+		const bool is_edge_live[3][3] = {
+			{ top & west_bit, top, top & east_bit },
+			{ columns & west_bit, false, columns & east_bit },
+			{ bottom & west_bit, bottom, bottom & east_bit }
+		};
+		const int64_t x = chunk->x;
+		const int64_t y = chunk->y;
+		for (int64_t dy = -1; dy <= 1; dy++)
+			for (int64_t dx = -1; dx <= 1; dx++)
+				if (is_edge_live[dy + 1][dx + 1] && insert_chunk(plane, x + dx, y + dy) == NIL)
+					return false;
+	}
+	return true;
+}
+
+static void activate(plane_t* const plane) {
+	for (uint32_t i = 0; i < plane->num_chunks; i++) {
+		plane_chunk_t* const chunk = &plane->chunks[i];
+		if (!chunk->is_used)
+			continue;
+		chunk->is_active = chunk->is_changed;
+		for (int64_t dy = -1; dy <= 1 && !chunk->is_active; dy++)
+			for (int64_t dx = -1; dx <= 1 && !chunk->is_active; dx++) {
+				const uint32_t neighbor = find_chunk(plane, chunk->x + dx, chunk->y + dy);
+				chunk->is_active = neighbor != NIL && plane->chunks[neighbor].is_changed;
+			}
+	}
+}
+
+static bool is_near_live(const plane_t* const plane, const uint32_t chunk) {
+	const plane_chunk_t* const center = &plane->chunks[chunk];
+	for (int64_t dy = -1; dy <= 1; dy++)
+		for (int64_t dx = -1; dx <= 1; dx++) {
+			const uint32_t neighbor = find_chunk(plane, center->x + dx, center->y + dy);
+			if (neighbor != NIL && plane->chunks[neighbor].hash)
+				return true;
+		}
+	return false;
+}
+
+static void get_neighborhood_row(
+	const plane_t* const plane,
+	const uint32_t* const neighbors,
+	const int32_t row,
+	uint64_t* const west,
+	uint64_t* const cells,
+	uint64_t* const east
+) {
+	const uint32_t* const band = neighbors + 3 * (row < 0 ? 0 : row < PLANE_CHUNK_SIZE ? 1 : 2);
+	const uint32_t index = (uint32_t)(row + PLANE_CHUNK_SIZE) % PLANE_CHUNK_SIZE;
+	const uint64_t west_word = band[0] == NIL ? 0 : plane->chunks[band[0]].rows[plane->current][index];
+	const uint64_t word = band[1] == NIL ? 0 : plane->chunks[band[1]].rows[plane->current][index];
+	const uint64_t east_word = band[2] == NIL ? 0 : plane->chunks[band[2]].rows[plane->current][index];
+	*west = (word << 1) | (west_word >> (PLANE_CHUNK_SIZE - 1));
+	*cells = word;
+	*east = (word >> 1) | (east_word << (PLANE_CHUNK_SIZE - 1));
+}
+
+static bool compute_chunk(plane_t* const plane, const uint32_t chunk) {
+	plane_chunk_t* const computed = &plane->chunks[chunk];
+	uint32_t neighbors[9];
+	for (int64_t dy = -1; dy <= 1; dy++)
+		for (int64_t dx = -1; dx <= 1; dx++)
+			neighbors[3 * (dy + 1) + dx + 1] = find_chunk(plane, computed->x + dx, computed->y + dy);
+
+	// slide a window of three rows down the chunk
+	uint64_t window[3][3];
+	get_neighborhood_row(plane, neighbors, -1, &window[0][0], &window[0][1], &window[0][2]);
+	get_neighborhood_row(plane, neighbors, 0, &window[1][0], &window[1][1], &window[1][2]);
+	uint64_t* const new_rows = computed->rows[plane->current ^ 1];
+	bool changed = false;
+	for (int32_t row = 0; row < PLANE_CHUNK_SIZE; row++) {
+		uint64_t* const above = window[row % 3];
+		uint64_t* const middle = window[(row + 1) % 3];
+		uint64_t* const below = window[(row + 2) % 3];
+		get_neighborhood_row(plane, neighbors, row + 1, &below[0], &below[1], &below[2]);
+		new_rows[row] = bitboard_compute_word(
+			&plane->rule,
+			above[0], above[1], above[2],
+			middle[0], middle[1], middle[2],
+			below[0], below[1], below[2]
+		);
+		if (new_rows[row] != middle[1])
+			changed = true;
+	}
+	return changed;
+}
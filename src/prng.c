@@ -0,0 +1,74 @@
+/**
+ * @file prng.c
+ * @brief Seeded pseudorandom generation of Game of Life soups.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <prng.h>
+
+/**
+ * @brief The increment of the splitmix64 generator expanding a seed.
+ */
+static const uint64_t SPLITMIX_INCREMENT = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Multiplier separating the streams of a seed.
+ */
+static const uint64_t STREAM_MULTIPLIER = 0xD1342543DE82EF95ULL;
+
+/**
+ * @brief Rotate a word left.
+ * @param[in] word The word to rotate.
+ * @param[in] bits The number of bits to rotate by, from 1 to 63.
+ * @return The rotated word.
+ */
+static uint64_t rotate_left(const uint64_t word, const uint8_t bits);
+
+/**
+ * @brief Advance a splitmix64 generator.
+ * @param[in,out] state The state of the generator.
+ * @return The next word.
+ */
+static uint64_t splitmix(uint64_t* const state);
+
+void prng_seed(prng_t* const prng, const uint64_t seed, const uint64_t stream) {
+	uint64_t state = seed ^ (stream * STREAM_MULTIPLIER);
+	for (uint32_t i = 0; i < 4; i++)
+		prng->state[i] = splitmix(&state);
+}
+
+uint64_t prng_next(prng_t* const prng) {
+	uint64_t* const s = prng->state;
+	const uint64_t result = rotate_left(s[1] * 5, 7) * 9;
+	const uint64_t t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotate_left(s[3], 45);
+	return result;
+}
+
+uint64_t prng_next_bits(prng_t* const prng, const uint32_t probability) {
+	if (!probability)
+		return 0;
+	if (probability >= (uint32_t)1 << PRNG_PROBABILITY_BITS)
+		return UINT64_MAX;
+	uint64_t bits = 0;
+	for (uint32_t i = (uint32_t)__builtin_ctz(probability); i < PRNG_PROBABILITY_BITS; i++)
+		bits = (probability >> i) & 1 ? bits | prng_next(prng) : bits & prng_next(prng);
+	return bits;
+}
+
+static uint64_t rotate_left(const uint64_t word, const uint8_t bits) {
+	return (word << bits) | (word >> (64 - bits));
+}
+
+static uint64_t splitmix(uint64_t* const state) {
+	uint64_t z = (*state += SPLITMIX_INCREMENT);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
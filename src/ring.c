@@ -0,0 +1,89 @@
+/**
+ * @file ring.c
+ * @brief Lock-free single-producer, single-consumer ring of fixed-size frames.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <ring.h>
+#include <errno.h>
+#include <stdlib.h>
+
+/**
+ * @brief Wait for a semaphore to be posted, resuming if interrupted.
+ * @param[in,out] semaphore The semaphore to wait for.
+ */
+static void wait_semaphore(sem_t* const semaphore);
+
+bool ring_init(ring_t* const ring, const uint32_t capacity, const size_t frame_size) {
+	ring->frame_size = frame_size;
+	ring->capacity = capacity;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	atomic_init(&ring->is_closed, false);
+	ring->frames = (uint8_t*)malloc(capacity * frame_size);
+	if (!ring->frames)
+		return false;
+	if (sem_init(&ring->space, 0, 0)) {
+		free(ring->frames);
+		ring->frames = NULL;
+		return false;
+	}
+	if (sem_init(&ring->filled, 0, 0)) {
+		sem_destroy(&ring->space);
+		free(ring->frames);
+		ring->frames = NULL;
+		return false;
+	}
+	return true;
+}
+
+void ring_destroy(ring_t* const ring) {
+	if (!ring->frames)
+		return;
+	free(ring->frames);
+	ring->frames = NULL;
+	sem_destroy(&ring->space);
+	sem_destroy(&ring->filled);
+}
+
+uint8_t* ring_begin_push(ring_t* const ring) {
+	// only the producer moves the head, so it can be read relaxed
+	const uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) == ring->capacity)
+		wait_semaphore(&ring->space);
+	return ring->frames + (head % ring->capacity) * ring->frame_size;
+}
+
+void ring_end_push(ring_t* const ring) {
+	const uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+	sem_post(&ring->filled);
+}
+
+const uint8_t* ring_begin_pop(ring_t* const ring) {
+	// only the consumer moves the tail, so it can be read relaxed
+	const uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	while (atomic_load_explicit(&ring->head, memory_order_acquire) == tail) {
+		if (atomic_load_explicit(&ring->is_closed, memory_order_acquire) &&
+		    atomic_load_explicit(&ring->head, memory_order_acquire) == tail)
+			return NULL;
+		wait_semaphore(&ring->filled);
+	}
+	return ring->frames + (tail % ring->capacity) * ring->frame_size;
+}
+
+void ring_end_pop(ring_t* const ring) {
+	const uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	sem_post(&ring->space);
+}
+
+void ring_close(ring_t* const ring) {
+	atomic_store_explicit(&ring->is_closed, true, memory_order_release);
+	sem_post(&ring->filled);
+}
+
+static void wait_semaphore(sem_t* const semaphore) {
+	while (sem_wait(semaphore) && errno == EINTR);
+}
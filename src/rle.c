@@ -0,0 +1,216 @@
+/**
+ * @file rle.c
+ * @brief Reading and writing of run-length encoded (RLE) patterns.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <rle.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief The number of bytes read from a pattern file at once.
+ */
+#define BLOCK_SIZE 65536
+
+/**
+ * @brief The longest line written, excluding the newline.
+ */
+static const uint32_t MAX_LINE_LENGTH = 70;
+
+/**
+ * @brief The longest run written as a single token, keeping its count within
+ *        the nine digits that fit any line.
+ */
+static const uint64_t MAX_RUN = 999999999;
+
+/**
+ * @brief The state of a pattern being written.
+ *
+ * Empty rows are deferred into `pending_rows` until a live cell follows, so
+ * they can be written as a single run, or dropped at the end of the pattern.
+ */
+typedef struct {
+	FILE* file;
+	uint32_t line_length;
+	uint64_t pending_rows;
+	bool is_ok;
+} writer_t;
+
+/**
+ * @brief Write a run of a tag, wrapping the line if the run does not fit.
+ * @param[in,out] writer The state of the pattern being written.
+ * @param[in] count The length of the run, written as a count if above one.
+ * @param[in] tag The tag: `b` (dead), `o` (live), `$` (end of row), or `!`
+ *                (end of pattern).
+ */
+static void write_run(writer_t* const writer, uint64_t count, const char tag);
+
+/**
+ * @brief Write the empty rows deferred until a live cell.
+ * @param[in,out] writer The state of the pattern being written.
+ */
+static void flush_rows(writer_t* const writer);
+
+bool rle_detect(const char* const filename, FILE* const file) {
+	const char* const extension = strrchr(filename, '.');
+	if (extension && !strcmp(extension, ".rle"))
+		return true;
+	const int character = getc(file);
+	if (character == EOF)
+		return false;
+	ungetc(character, file);
+	return character == '#' || character == 'x';
+}
+
+rle_result_t rle_read_header(FILE* const file, rle_header_t* const header) {
+	char* line = NULL;
+	size_t line_len = 0;
+	rle_result_t result = RLE_BAD_HEADER;
+	ssize_t length;
+	while ((length = getline(&line, &line_len, file)) > 0 && line[0] == '#');
+	if (length <= 0)
+		goto EXIT;
+	int64_t width, height;
+	int consumed = 0;
+	if (sscanf(line, " x = %" SCNd64 " , y = %" SCNd64 "%n", &width, &height, &consumed) < 2)
+		goto EXIT;
+	result = RLE_BAD_DIMENSION;
+	if (width <= 0 || width > UINT32_MAX || height <= 0 || height > UINT32_MAX)
+		goto EXIT;
+	header->width = (uint32_t)width;
+	header->height = (uint32_t)height;
+	header->rule[0] = '\0';
+	const char* const rule = strstr(line + consumed, "rule");
+	result = RLE_BAD_HEADER;
+	if (rule && sscanf(rule, "rule = %63[^, \t\r\n]", header->rule) < 1)
+		goto EXIT;
+	result = RLE_OK;
+EXIT:
+	free(line);
+	return result;
+}
+
+rle_result_t rle_read_cells(
+	FILE* const file,
+	const rle_header_t* const header,
+	uint8_t* const cells,
+	const size_t stride
+) {
+	char* const block = (char*)malloc(BLOCK_SIZE);
+	if (!block)
+		return RLE_BAD_DIMENSION;
+	rle_result_t result = RLE_OK;
+	uint64_t run = 0;
+	uint64_t row = 0, col = 0;
+	bool is_done = false;
+	size_t num_read;
+	while (!is_done && (num_read = fread(block, 1, BLOCK_SIZE, file))) {
+		for (size_t i = 0; i < num_read; i++) {
+			const char character = block[i];
+			if (character >= '0' && character <= '9') {
+				run = run * 10 + (uint64_t)(character - '0');
+				if (run > UINT32_MAX) {
+					result = RLE_BAD_DIMENSION;
+					goto EXIT;
+				}
+				continue;
+			}
+			const uint64_t count = run ? run : 1;
+			run = 0;
+			switch (character) {
+				case 'b':
+				case 'o':
+					if (row >= header->height || col + count > header->width) {
+						result = RLE_BAD_DIMENSION;
+						goto EXIT;
+					}
+					if (character == 'o')
+						memset(cells + stride * row + col, 1, count);
+					col += count;
+					break;
+				case '$':
+					row += count;
+					col = 0;
+					break;
+				case '!':
+					is_done = true;
+					break;
+				case ' ':
+				case '\t':
+				case '\r':
+				case '\n':
+					break;
+				default:
+					result = RLE_BAD_CELL;
+					goto EXIT;
+			}
+			if (is_done)
+				break;
+		}
+	}
+EXIT:
+	free(block);
+	return result;
+}
+
+bool rle_write(
+	FILE* const file,
+	const uint8_t* const cells,
+	const size_t stride,
+	const uint32_t width,
+	const uint32_t height,
+	const uint8_t live
+) {
+	writer_t writer = { file, 0, 0, true };
+	writer.is_ok = fprintf(file, "x = %" PRIu32 ", y = %" PRIu32 ", rule = B3/S23\n", width, height) > 0;
+	for (uint32_t row = 0; row < height; row++) {
+		const uint8_t* const row_cells = cells + stride * row;
+		uint32_t col = 0;
+		while (col < width) {
+			const bool is_live = row_cells[col] == live;
+			uint32_t end = col + 1;
+			while (end < width && (row_cells[end] == live) == is_live)
+				end++;
+
+			// dead cells ending a row are implied
+			if (is_live) {
+				flush_rows(&writer);
+				write_run(&writer, end - col, 'o');
+			} else if (end < width) {
+				flush_rows(&writer);
+				write_run(&writer, end - col, 'b');
+			}
+			col = end;
+		}
+		writer.pending_rows++;
+	}
+	write_run(&writer, 1, '!');
+	writer.is_ok = fputc('\n', file) != EOF && writer.is_ok;
+	return writer.is_ok;
+}
+
+static void write_run(writer_t* const writer, uint64_t count, const char tag) {
+	while (count) {
+		const uint64_t length = count > MAX_RUN ? MAX_RUN : count;
+		char token[16];
+		const int token_length = length > 1
+			? snprintf(token, sizeof(token), "%" PRIu64 "%c", length, tag)
+			: snprintf(token, sizeof(token), "%c", tag);
+		if (writer->line_length + (uint32_t)token_length > MAX_LINE_LENGTH) {
+			writer->is_ok = fputc('\n', writer->file) != EOF && writer->is_ok;
+			writer->line_length = 0;
+		}
+		writer->is_ok = fputs(token, writer->file) != EOF && writer->is_ok;
+		writer->line_length += (uint32_t)token_length;
+		count -= length;
+	}
+}
+
+static void flush_rows(writer_t* const writer) {
+	if (writer->pending_rows)
+		write_run(writer, writer->pending_rows, '$');
+	writer->pending_rows = 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file rule.c
+ * @brief Outer-totalistic Life-like rules compiled from rule strings.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <rule.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief The masks of the rules with specialized kernels.
+ */
+static const rule_t SPECIALIZED_RULES[] = {
+	{ 1 << 3, 1 << 2 | 1 << 3, 2, RULE_LIFE },
+	{ 1 << 3 | 1 << 6, 1 << 2 | 1 << 3, 2, RULE_HIGHLIFE },
+	{ 1 << 3 | 1 << 6 | 1 << 7 | 1 << 8, 1 << 3 | 1 << 4 | 1 << 6 | 1 << 7 | 1 << 8, 2, RULE_DAY_AND_NIGHT },
+};
+
+/**
+ * @brief Compile a list of neighbor counts into a mask.
+ * @param[in] begin The first digit of the list.
+ * @param[in] end One past the last digit of the list.
+ * @param[out] mask The mask, with bit n set for each count n listed.
+ * @return True if every character is a count from 0 to 8, false otherwise.
+ */
+static bool parse_counts(const char* const begin, const char* const end, uint16_t* const mask);
+
+/**
+ * @brief Parse the number of states of a Generations rule.
+ * @param[in] string The number of states, ending the rule string.
+ * @param[out] num_states The number of states.
+ * @return True if the string is a number from 2 to `RULE_MAX_STATES`, false
+ *         otherwise.
+ */
+static bool parse_states(const char* const string, uint16_t* const num_states);
+
+bool rule_parse(const char* const string, rule_t* const rule) {
+	const char* const slash = strchr(string, '/');
+	if (!slash)
+		return false;
+
+	// a third part holds the number of states of a Generations rule
+	const char* const states = strchr(slash + 1, '/');
+	const char* const end = states ? states : slash + strlen(slash);
+	const char first = (char)tolower((unsigned char)string[0]);
+	const char second = (char)tolower((unsigned char)slash[1]);
+	bool is_parsed;
+	if (first == 'b' && second == 's')
+		is_parsed = parse_counts(string + 1, slash, &rule->birth) && parse_counts(slash + 2, end, &rule->survival);
+	else if (first == 's' && second == 'b')
+		is_parsed = parse_counts(string + 1, slash, &rule->survival) && parse_counts(slash + 2, end, &rule->birth);
+	else
+		is_parsed = parse_counts(string, slash, &rule->survival) && parse_counts(slash + 1, end, &rule->birth);
+	if (!is_parsed || rule->birth & 1)
+		return false;
+	rule->num_states = 2;
+	if (states) {
+		const bool is_lettered = first == 'b' || first == 's';
+		if (is_lettered && tolower((unsigned char)states[1]) != 'c')
+			return false;
+		if (!parse_states(states + 1 + is_lettered, &rule->num_states))
+			return false;
+	}
+
+	rule->kind = RULE_GENERIC;
+	for (size_t i = 0; i < sizeof(SPECIALIZED_RULES) / sizeof(SPECIALIZED_RULES[0]); i++)
+		if (rule->birth == SPECIALIZED_RULES[i].birth &&
+		    rule->survival == SPECIALIZED_RULES[i].survival &&
+		    rule->num_states == SPECIALIZED_RULES[i].num_states)
+			rule->kind = SPECIALIZED_RULES[i].kind;
+	return true;
+}
+
+bool rule_apply(const rule_t* const rule, const bool is_live, const uint8_t num_live_neighbors) {
+	return ((is_live ? rule->survival : rule->birth) >> num_live_neighbors) & 1;
+}
+
+static bool parse_counts(const char* const begin, const char* const end, uint16_t* const mask) {
+	*mask = 0;
+	for (const char* c = begin; c < end; c++) {
+		if (*c < '0' || *c > '8')
+			return false;
+		*mask |= (uint16_t)(1 << (*c - '0'));
+	}
+	return true;
+}
+
+static bool parse_states(const char* const string, uint16_t* const num_states) {
+	const size_t length = strlen(string);
+	if (!length || length > 3 || strspn(string, "0123456789") != length)
+		return false;
+	const unsigned long value = strtoul(string, NULL, 10);
+	if (value < 2 || value > RULE_MAX_STATES)
+		return false;
+	*num_states = (uint16_t)value;
+	return true;
+}
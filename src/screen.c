@@ -0,0 +1,214 @@
+/**
+ * @file screen.c
+ * @brief Terminal screen repainting only the cells that changed.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <screen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief The percentage of cells that may change before a frame is repainted
+ *        in full rather than cell run by cell run.
+ */
+static const uint8_t FULL_REPAINT_PERCENT = 25;
+
+/**
+ * @brief The number of unchanged cells between two changed ones below which
+ *        repainting them is cheaper than moving the cursor past them.
+ */
+static const uint32_t MIN_SKIPPED_CELLS = 8;
+
+/**
+ * @brief ANSI control code to move the cursor to the top-left position.
+ */
+static const char* CURSOR_HOME = "\x1b[H";
+
+/**
+ * @brief The longest ANSI control code moving the cursor to a position.
+ */
+#define CURSOR_MOVE_MAX_SIZE sizeof("\x1b[4294967295;4294967295H")
+
+/**
+ * @brief Append a run of cells of the frame to the output, emitting colors
+ *        only where they change.
+ * @param[in,out] screen The screen.
+ * @param[in] begin The index of the first cell of the run.
+ * @param[in] end One past the index of the last cell of the run.
+ * @param[in,out] color The color the terminal is set to.
+ */
+static void append_cells(
+	screen_t* const screen,
+	const size_t begin,
+	const size_t end,
+	uint8_t* const color
+);
+
+/**
+ * @brief Append a movement of the cursor to a position to the output.
+ * @param[in,out] screen The screen.
+ * @param[in] row The row to move to.
+ * @param[in] col The column to move to.
+ */
+static void append_cursor_move(screen_t* const screen, const uint32_t row, const uint32_t col);
+
+/**
+ * @brief Append every cell of the frame to the output.
+ * @param[in,out] screen The screen.
+ */
+static void repaint_all(screen_t* const screen);
+
+/**
+ * @brief Append the runs of cells of the frame differing from the shown frame
+ *        to the output.
+ * @param[in,out] screen The screen.
+ * @return True if the changes were appended, false if too many cells changed
+ *         and nothing was appended.
+ */
+static bool repaint_changes(screen_t* const screen);
+
+bool screen_init(
+	screen_t* const screen,
+	const uint32_t width,
+	const uint32_t height,
+	const char* const* palette,
+	const int fd
+) {
+	screen->width = width;
+	screen->height = height;
+	screen->palette = palette;
+	screen->is_shown = false;
+	screen->chars = NULL;
+	screen->colors = NULL;
+	screen->shown_chars = NULL;
+	screen->shown_colors = NULL;
+	screen->frame.data = NULL;
+	if (!width || !height || width > SIZE_MAX / height)
+		return false;
+	const size_t size = (size_t)width * height;
+	screen->chars = (char*)malloc(size);
+	screen->colors = (uint8_t*)malloc(size);
+	screen->shown_chars = (char*)malloc(size);
+	screen->shown_colors = (uint8_t*)malloc(size);
+	if (!screen->chars || !screen->colors || !screen->shown_chars || !screen->shown_colors) {
+		screen_destroy(screen);
+		return false;
+	}
+
+	// a frame without color changes holds each row, a reset and a newline
+	const size_t row_size = (size_t)width + strlen(palette[0]) + 1;
+	if (row_size > (SIZE_MAX - strlen(CURSOR_HOME)) / height ||
+	    !framebuf_init(&screen->frame, row_size * height + strlen(CURSOR_HOME), fd)) {
+		screen_destroy(screen);
+		return false;
+	}
+	return true;
+}
+
+void screen_present(screen_t* const screen) {
+	if (!screen->is_shown || !repaint_changes(screen))
+		repaint_all(screen);
+	framebuf_flush(&screen->frame);
+	screen->is_shown = true;
+
+	// the presented frame becomes the one to compare the next frame against
+	char* const chars = screen->shown_chars;
+	uint8_t* const colors = screen->shown_colors;
+	screen->shown_chars = screen->chars;
+	screen->shown_colors = screen->colors;
+	screen->chars = chars;
+	screen->colors = colors;
+}
+
+void screen_invalidate(screen_t* const screen) {
+	screen->is_shown = false;
+}
+
+void screen_destroy(screen_t* const screen) {
+	free(screen->chars);
+	free(screen->colors);
+	free(screen->shown_chars);
+	free(screen->shown_colors);
+	screen->chars = NULL;
+	screen->colors = NULL;
+	screen->shown_chars = NULL;
+	screen->shown_colors = NULL;
+	framebuf_destroy(&screen->frame);
+}
+
+static void append_cells(
+	screen_t* const screen,
+	const size_t begin,
+	const size_t end,
+	uint8_t* const color
+) {
+	for (size_t i = begin; i < end; i++) {
+		if (screen->colors[i] != *color) {
+			*color = screen->colors[i];
+			framebuf_append_string(&screen->frame, screen->palette[*color]);
+		}
+		framebuf_append_char(&screen->frame, screen->chars[i]);
+	}
+}
+
+static void append_cursor_move(screen_t* const screen, const uint32_t row, const uint32_t col) {
+	char move[CURSOR_MOVE_MAX_SIZE];
+	const int size = snprintf(move, sizeof(move), "\x1b[%u;%uH", row + 1, col + 1);
+	framebuf_append(&screen->frame, move, (size_t)size);
+}
+
+static void repaint_all(screen_t* const screen) {
+	framebuf_append_string(&screen->frame, CURSOR_HOME);
+	for (uint32_t row = 0; row < screen->height; row++) {
+		// each row starts from the default colors set at the end of the
+		// previous one
+		uint8_t color = 0;
+		const size_t begin = (size_t)screen->width * row;
+		append_cells(screen, begin, begin + screen->width, &color);
+		framebuf_append_string(&screen->frame, screen->palette[0]);
+		framebuf_append_char(&screen->frame, '\n');
+	}
+}
+
+static bool repaint_changes(screen_t* const screen) {
+	const size_t max_changes = (size_t)((uint64_t)screen->width * screen->height * FULL_REPAINT_PERCENT / 100);
+	size_t changes = 0;
+	bool is_changed = false;
+	uint8_t color = 0;
+	for (uint32_t row = 0; row < screen->height; row++) {
+		const size_t row_begin = (size_t)screen->width * row;
+		for (uint32_t col = 0; col < screen->width; col++) {
+			const size_t i = row_begin + col;
+			if (screen->chars[i] == screen->shown_chars[i] && screen->colors[i] == screen->shown_colors[i])
+				continue;
+
+			// extend the run over changed cells, bridging short gaps
+			uint32_t run_end = col + 1;
+			for (uint32_t next = run_end; next < screen->width && next - run_end < MIN_SKIPPED_CELLS; next++) {
+				const size_t j = row_begin + next;
+				if (screen->chars[j] != screen->shown_chars[j] || screen->colors[j] != screen->shown_colors[j])
+					run_end = next + 1;
+			}
+			changes += run_end - col;
+			if (changes > max_changes) {
+				framebuf_clear(&screen->frame);
+				return false;
+			}
+			append_cursor_move(screen, row, col);
+			append_cells(screen, i, row_begin + run_end, &color);
+			is_changed = true;
+			col = run_end - 1;
+		}
+	}
+
+	// leave the cursor where a full repaint would
+	if (is_changed) {
+		if (color)
+			framebuf_append_string(&screen->frame, screen->palette[0]);
+		append_cursor_move(screen, screen->height, 0);
+	}
+	return true;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file stats.c
+ * @brief Timing of the phases of a Game of Life run.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <stats.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief The names of the phases, as printed.
+ */
+static const char* const PHASE_NAMES[] = { "init", "compute", "capture", "render", "wait" };
+
+/**
+ * @brief The number of nanoseconds per second.
+ */
+static const uint64_t NANOS_PER_SECOND = 1000000000;
+
+/**
+ * @brief The width of the longest bar of a histogram, in characters.
+ */
+static const uint32_t BAR_WIDTH = 40;
+
+/**
+ * @brief Find the histogram bucket of a sample.
+ * @param[in] nanos The sample in nanoseconds.
+ * @return The index of the bucket.
+ */
+static uint32_t get_bucket(const uint64_t nanos);
+
+/**
+ * @brief Print a duration with a unit suited to its magnitude.
+ * @param[in,out] stream The stream to print to.
+ * @param[in] nanos The duration in nanoseconds.
+ */
+static void print_duration(FILE* const stream, const double nanos);
+
+void stats_init(stats_t* const stats, const bool is_enabled) {
+	memset(stats, 0, sizeof(stats_t));
+	for (uint32_t phase = 0; phase < STATS_NUM_PHASES; phase++)
+		stats->timers[phase].min = UINT64_MAX;
+	stats->is_enabled = is_enabled;
+}
+
+uint64_t stats_start(const stats_t* const stats) {
+	if (!stats->is_enabled)
+		return 0;
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * NANOS_PER_SECOND + (uint64_t)now.tv_nsec;
+}
+
+uint64_t stats_record(stats_t* const stats, const stats_phase_t phase, const uint64_t start) {
+	if (!stats->is_enabled)
+		return 0;
+	const uint64_t now = stats_start(stats);
+	const uint64_t nanos = now - start;
+	stats_timer_t* const timer = &stats->timers[phase];
+	timer->count++;
+	timer->total += nanos;
+	if (nanos < timer->min)
+		timer->min = nanos;
+	if (nanos > timer->max)
+		timer->max = nanos;
+	timer->histogram[get_bucket(nanos)]++;
+	return now;
+}
+
+void stats_print(const stats_t* const stats, FILE* const stream) {
+	for (uint32_t phase = 0; phase < STATS_NUM_PHASES; phase++) {
+		const stats_timer_t* const timer = &stats->timers[phase];
+		if (!timer->count)
+			continue;
+		fprintf(stream, "%s: %" PRIu64 " samples, total ", PHASE_NAMES[phase], timer->count);
+		print_duration(stream, (double)timer->total);
+		fprintf(stream, ", average ");
+		print_duration(stream, (double)timer->total / (double)timer->count);
+		fprintf(stream, ", min ");
+		print_duration(stream, (double)timer->min);
+		fprintf(stream, ", max ");
+		print_duration(stream, (double)timer->max);
+		fprintf(stream, "\n");
+
+		uint64_t max_count = 0;
+		for (uint32_t bucket = 0; bucket < STATS_BUCKETS; bucket++)
+			if (timer->histogram[bucket] > max_count)
+				max_count = timer->histogram[bucket];
+		for (uint32_t bucket = 0; bucket < STATS_BUCKETS; bucket++) {
+			const uint64_t count = timer->histogram[bucket];
+			if (!count)
+				continue;
+			fprintf(stream, "  >= ");
+			print_duration(stream, (double)((uint64_t)1 << bucket));
+			fprintf(stream, "\t%10" PRIu64 " ", count);
+			const uint32_t bar = (uint32_t)((count * BAR_WIDTH + max_count - 1) / max_count);
+			for (uint32_t i = 0; i < bar; i++)
+				fputc('#', stream);
+			fputc('\n', stream);
+		}
+	}
+}
+
+static uint32_t get_bucket(const uint64_t nanos) {
+	if (!nanos)
+		return 0;
+	const uint32_t bucket = 63 - (uint32_t)__builtin_clzll(nanos);
+	return bucket < STATS_BUCKETS ? bucket : STATS_BUCKETS - 1;
+}
+
+static void print_duration(FILE* const stream, const double nanos) {
+	if (nanos >= 1e9)
+		fprintf(stream, "%.3f s", nanos / 1e9);
+	else if (nanos >= 1e6)
+		fprintf(stream, "%.3f ms", nanos / 1e6);
+	else if (nanos >= 1e3)
+		fprintf(stream, "%.3f us", nanos / 1e3);
+	else
+		fprintf(stream, "%.0f ns", nanos);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file threadpool.c
+ * @brief Persistent pool of threads splitting work into bands.
+ * @author Justin Thoreson
+ * @date 2025
+ */
+
+#include <threadpool.h>
+#include <stdlib.h>
+
+struct threadpool_worker {
+	threadpool_t* pool;
+	uint32_t band;
+	pthread_t thread;
+};
+
+/**
+ * @brief The loop executed by each worker thread until the pool stops.
+ * @param[in] arg The worker running the loop.
+ * @return Nothing.
+ */
+static void* run_worker(void* arg);
+
+/**
+ * @brief Stop and join the first workers of a pool.
+ * @param[in,out] pool The pool whose workers are stopped.
+ * @param[in] num_workers The number of workers that were spawned.
+ */
+static void stop_workers(threadpool_t* const pool, const uint32_t num_workers);
+
+bool threadpool_init(threadpool_t* const pool, const uint32_t num_threads) {
+	pool->num_threads = num_threads ? num_threads : 1;
+	pool->workers = NULL;
+	pool->generation = 0;
+	pool->task = NULL;
+	pool->context = NULL;
+	pool->stopping = false;
+	if (pool->num_threads == 1)
+		return true;
+	pool->workers = (threadpool_worker_t*)calloc(pool->num_threads - 1, sizeof(threadpool_worker_t));
+	if (!pool->workers)
+		return false;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	pthread_barrier_init(&pool->finish, NULL, pool->num_threads);
+	for (uint32_t i = 0; i < pool->num_threads - 1; i++) {
+		threadpool_worker_t* const worker = &pool->workers[i];
+		worker->pool = pool;
+		worker->band = i + 1;
+		if (pthread_create(&worker->thread, NULL, run_worker, worker)) {
+			stop_workers(pool, i);
+			return false;
+		}
+	}
+	return true;
+}
+
+void threadpool_run(
+	threadpool_t* const pool,
+	const threadpool_task_t task,
+	void* const context
+) {
+	if (pool->num_threads == 1) {
+		task(context, 0, 1);
+		return;
+	}
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->context = context;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	task(context, 0, pool->num_threads);
+	pthread_barrier_wait(&pool->finish);
+}
+
+void threadpool_destroy(threadpool_t* const pool) {
+	if (pool->workers)
+		stop_workers(pool, pool->num_threads - 1);
+}
+
+static void* run_worker(void* arg) {
+	threadpool_worker_t* const worker = (threadpool_worker_t*)arg;
+	threadpool_t* const pool = worker->pool;
+	uint64_t generation = 0;
+	for (;;) {
+		pthread_mutex_lock(&pool->lock);
+		while (pool->generation == generation && !pool->stopping)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		generation = pool->generation;
+		const bool stopping = pool->stopping;
+		pthread_mutex_unlock(&pool->lock);
+		if (stopping)
+			break;
+		pool->task(pool->context, worker->band, pool->num_threads);
+		pthread_barrier_wait(&pool->finish);
+	}
+	return NULL;
+}
+
+static void stop_workers(threadpool_t* const pool, const uint32_t num_workers) {
+	pthread_mutex_lock(&pool->lock);
+	pool->stopping = true;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	for (uint32_t i = 0; i < num_workers; i++)
+		pthread_join(pool->workers[i].thread, NULL);
+	pthread_barrier_destroy(&pool->finish);
+	pthread_cond_destroy(&pool->wake);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->workers);
+	pool->workers = NULL;
+}